@@ -175,9 +175,9 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                     // If there are no remaining commands (from the previous list),
                     // this is a new command list, initialize it.
                     if (command_buffer.remaining_command_count == 0) {
-                        command_list_processor.Initialize(system, *command_buffer.process,
-                                                          command_buffer.buffer,
-                                                          command_buffer.size, streams[index]);
+                        command_list_processor.Initialize(
+                            system, *command_buffer.process, command_buffer.buffer,
+                            command_buffer.size, streams[index], command_buffer.reset_buffer);
                     }
 
                     if (command_buffer.reset_buffer && !buffers_reset[index]) {
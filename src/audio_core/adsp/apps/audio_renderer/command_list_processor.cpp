@@ -15,7 +15,8 @@
 namespace AudioCore::ADSP::AudioRenderer {
 
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
-                                      CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
+                                      CpuAddr buffer, u64 size, Sink::SinkStream* stream_,
+                                      bool reset) {
     system = &system_;
     memory = &process.GetMemory();
     stream = stream_;
@@ -28,6 +29,11 @@ void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& p
     mix_buffers = header->samples_buffer;
     buffer_count = header->buffer_count;
     processed_command_count = 0;
+    // The cache is kept across the command lists of a session, a new session's voices are
+    // unrelated to the previous one's
+    if (!adpcm_cache || reset) {
+        adpcm_cache = std::make_unique<Renderer::AdpcmDecodeCache>();
+    }
 }
 
 void CommandListProcessor::SetProcessTimeMax(const u64 time) {
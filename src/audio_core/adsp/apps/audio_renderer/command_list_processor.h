@@ -3,10 +3,12 @@
 
 #pragma once
 
+#include <memory>
 #include <span>
 
 #include "audio_core/common/common.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/data_source/decode.h"
 #include "common/common_types.h"
 
 namespace Core {
@@ -43,9 +45,10 @@ public:
      * @param buffer - The command buffer to process.
      * @param size   - The size of the buffer.
      * @param stream - The stream to be used for sending the samples.
+     * @param reset  - Is this the first command list of a new session?
      */
     void Initialize(Core::System& system, Kernel::KProcess& process, CpuAddr buffer, u64 size,
-                    Sink::SinkStream* stream);
+                    Sink::SinkStream* stream, bool reset);
 
     /**
      * Set the maximum processing time for this command list.
@@ -111,6 +114,8 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+    /// Decoded samples of the session's ADPCM voices, kept across command lists
+    std::unique_ptr<Renderer::AdpcmDecodeCache> adpcm_cache{};
 };
 
 } // namespace ADSP::AudioRenderer
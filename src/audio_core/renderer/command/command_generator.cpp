@@ -2,6 +2,8 @@
 // SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+
 #include "audio_core/common/audio_renderer_parameter.h"
 #include "audio_core/renderer/behavior/behavior_info.h"
 #include "audio_core/renderer/command/command_buffer.h"
@@ -144,6 +146,22 @@ void CommandGenerator::GenerateVoiceMixCommand(std::span<const f32> mix_volumes,
     }
 }
 
+void CommandGenerator::ClearVoiceMixSamples(std::span<const f32> mix_volumes,
+                                            std::span<const f32> prev_mix_volumes,
+                                            VoiceState& voice_state, const s16 buffer_count) {
+    const auto count{static_cast<size_t>(buffer_count)};
+    if (buffer_count > 8) {
+        std::fill_n(voice_state.previous_samples.begin(), count, 0);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (mix_volumes[i] != 0.0f || prev_mix_volumes[i] != 0.0f) {
+            voice_state.previous_samples[i] = 0;
+        }
+    }
+}
+
 void CommandGenerator::GenerateBiquadFilterCommandForVoice(VoiceInfo& voice_info,
                                                            const VoiceState& voice_state,
                                                            const s16 buffer_count, const s8 channel,
@@ -166,12 +184,52 @@ void CommandGenerator::GenerateBiquadFilterCommandForVoice(VoiceInfo& voice_info
     }
 }
 
-void CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
+bool CommandGenerator::IsVoiceChannelSilent(const VoiceInfo& voice_info,
+                                            const VoiceChannelResource& channel_resource,
+                                            const s8 channel) {
+    if (voice_info.volume == 0.0f && voice_info.prev_volume == 0.0f) {
+        return true;
+    }
+
+    const auto is_silent{[](std::span<const f32> volumes, std::span<const f32> prev_volumes,
+                            const s16 buffer_count) {
+        const auto count{static_cast<size_t>(buffer_count)};
+        const auto is_zero{[](const f32 volume) { return volume == 0.0f; }};
+        return std::ranges::all_of(volumes.first(count), is_zero) &&
+               std::ranges::all_of(prev_volumes.first(count), is_zero);
+    }};
+
+    if (voice_info.mix_id != UnusedMixId) {
+        const auto mix_info{mix_context.GetInfo(voice_info.mix_id)};
+        return is_silent(channel_resource.mix_volumes, channel_resource.prev_mix_volumes,
+                         mix_info->buffer_count);
+    }
+
+    auto i{channel};
+    auto destination{splitter_context.GetDestinationData(voice_info.splitter_id, i)};
+    while (destination != nullptr) {
+        if (destination->IsConfigured()) {
+            const auto mix_id{destination->GetMixId()};
+            if (mix_id < mix_context.GetCount() && static_cast<s32>(mix_id) != UnusedSplitterId &&
+                !is_silent(destination->GetMixVolume(), destination->GetMixVolumePrev(),
+                           mix_context.GetInfo(mix_id)->buffer_count)) {
+                return false;
+            }
+        }
+        i += voice_info.channel_count;
+        destination = splitter_context.GetDestinationData(voice_info.splitter_id, i);
+    }
+    return true;
+}
+
+bool CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
     u8 precision{15};
     if (render_context.behavior->IsVolumeMixParameterPrecisionQ23Supported()) {
         precision = 23;
     }
 
+    s8 culled_channels{0};
+
     for (s8 channel = 0; channel < voice_info.channel_count; channel++) {
         const auto resource_id{voice_info.channel_resource_ids[channel]};
         auto& voice_state{voice_context.GetDspSharedState(resource_id)};
@@ -220,14 +278,23 @@ void CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
                 biquad_detail_aspect.performance_entry_address);
         }
 
-        DetailAspect volume_ramp_detail_aspect(*this, PerformanceEntryType::Voice,
-                                               voice_info.node_id, PerformanceDetailType::Unk3);
-        command_buffer.GenerateVolumeRampCommand(
-            voice_info.node_id, voice_info, render_context.mix_buffer_count + channel, precision);
-        if (volume_ramp_detail_aspect.initialized) {
-            command_buffer.GeneratePerformanceCommand(
-                volume_ramp_detail_aspect.node_id, PerformanceState::Stop,
-                volume_ramp_detail_aspect.performance_entry_address);
+        // The data source and biquad filters above still run for a culled channel, so the play
+        // position and filter history carry on as if it was mixed.
+        const auto culled{IsVoiceChannelSilent(voice_info, channel_resource, channel)};
+        if (culled) {
+            culled_channels++;
+        } else {
+            DetailAspect volume_ramp_detail_aspect(*this, PerformanceEntryType::Voice,
+                                                   voice_info.node_id,
+                                                   PerformanceDetailType::Unk3);
+            command_buffer.GenerateVolumeRampCommand(voice_info.node_id, voice_info,
+                                                     render_context.mix_buffer_count + channel,
+                                                     precision);
+            if (volume_ramp_detail_aspect.initialized) {
+                command_buffer.GeneratePerformanceCommand(
+                    volume_ramp_detail_aspect.node_id, PerformanceState::Stop,
+                    volume_ramp_detail_aspect.performance_entry_address);
+            }
         }
 
         voice_info.prev_volume = voice_info.volume;
@@ -242,10 +309,17 @@ void CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
                         if (mix_id < mix_context.GetCount() &&
                             static_cast<s32>(mix_id) != UnusedSplitterId) {
                             auto mix_info{mix_context.GetInfo(mix_id)};
-                            GenerateVoiceMixCommand(
-                                destination->GetMixVolume(), destination->GetMixVolumePrev(),
-                                voice_state, mix_info->buffer_offset, mix_info->buffer_count,
-                                render_context.mix_buffer_count + channel, voice_info.node_id);
+                            if (culled) {
+                                ClearVoiceMixSamples(destination->GetMixVolume(),
+                                                     destination->GetMixVolumePrev(), voice_state,
+                                                     mix_info->buffer_count);
+                            } else {
+                                GenerateVoiceMixCommand(
+                                    destination->GetMixVolume(), destination->GetMixVolumePrev(),
+                                    voice_state, mix_info->buffer_offset, mix_info->buffer_count,
+                                    render_context.mix_buffer_count + channel,
+                                    voice_info.node_id);
+                            }
                             destination->MarkAsNeedToUpdateInternalState();
                         }
                     }
@@ -254,16 +328,25 @@ void CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
                 }
             }
         } else {
-            DetailAspect volume_mix_detail_aspect(*this, PerformanceEntryType::Voice,
-                                                  voice_info.node_id, PerformanceDetailType::Unk3);
-            auto mix_info{mix_context.GetInfo(voice_info.mix_id)};
-            GenerateVoiceMixCommand(channel_resource.mix_volumes, channel_resource.prev_mix_volumes,
-                                    voice_state, mix_info->buffer_offset, mix_info->buffer_count,
-                                    render_context.mix_buffer_count + channel, voice_info.node_id);
-            if (volume_mix_detail_aspect.initialized) {
-                command_buffer.GeneratePerformanceCommand(
-                    volume_mix_detail_aspect.node_id, PerformanceState::Stop,
-                    volume_mix_detail_aspect.performance_entry_address);
+            if (culled) {
+                ClearVoiceMixSamples(channel_resource.mix_volumes,
+                                     channel_resource.prev_mix_volumes, voice_state,
+                                     mix_context.GetInfo(voice_info.mix_id)->buffer_count);
+            } else {
+                DetailAspect volume_mix_detail_aspect(*this, PerformanceEntryType::Voice,
+                                                      voice_info.node_id,
+                                                      PerformanceDetailType::Unk3);
+                auto mix_info{mix_context.GetInfo(voice_info.mix_id)};
+                GenerateVoiceMixCommand(channel_resource.mix_volumes,
+                                        channel_resource.prev_mix_volumes, voice_state,
+                                        mix_info->buffer_offset, mix_info->buffer_count,
+                                        render_context.mix_buffer_count + channel,
+                                        voice_info.node_id);
+                if (volume_mix_detail_aspect.initialized) {
+                    command_buffer.GeneratePerformanceCommand(
+                        volume_mix_detail_aspect.node_id, PerformanceState::Stop,
+                        volume_mix_detail_aspect.performance_entry_address);
+                }
             }
 
             channel_resource.prev_mix_volumes = channel_resource.mix_volumes;
@@ -271,10 +354,14 @@ void CommandGenerator::GenerateVoiceCommand(VoiceInfo& voice_info) {
         voice_info.biquad_initialized[0] = voice_info.biquads[0].enabled;
         voice_info.biquad_initialized[1] = voice_info.biquads[1].enabled;
     }
+
+    return culled_channels > 0 && culled_channels == voice_info.channel_count;
 }
 
 void CommandGenerator::GenerateVoiceCommands() {
     const auto voice_count{voice_context.GetCount()};
+    u32 rendered_count{0};
+    u32 culled_count{0};
 
     for (u32 i = 0; i < voice_count; i++) {
         auto sorted_info{voice_context.GetSortedInfo(i)};
@@ -285,7 +372,10 @@ void CommandGenerator::GenerateVoiceCommands() {
 
         EntryAspect voice_entry_aspect(*this, PerformanceEntryType::Voice, sorted_info->node_id);
 
-        GenerateVoiceCommand(*sorted_info);
+        rendered_count++;
+        if (GenerateVoiceCommand(*sorted_info)) {
+            culled_count++;
+        }
 
         if (voice_entry_aspect.initialized) {
             command_buffer.GeneratePerformanceCommand(voice_entry_aspect.node_id,
@@ -294,6 +384,7 @@ void CommandGenerator::GenerateVoiceCommands() {
         }
     }
 
+    voice_context.SetRenderedCounts(rendered_count, culled_count);
     splitter_context.UpdateInternalState();
 }
 
@@ -23,6 +23,7 @@ class SinkContext;
 class BehaviorInfo;
 class VoiceInfo;
 struct VoiceState;
+class VoiceChannelResource;
 class MixInfo;
 class SinkInfoBase;
 
@@ -139,6 +140,20 @@ public:
                                  const VoiceState& voice_state, s16 output_index, s16 buffer_count,
                                  s16 input_index, s32 node_id);
 
+    /**
+     * Write the depop samples the voice mixing commands would have left for a culled channel.
+     * Culled channels only mix silence, so every sample a mix ramp would write is 0, but a
+     * single mix ramp is not generated at all for a buffer whose volume stays at 0.
+     *
+     * @param mix_volumes      - Current volumes of the skipped mix.
+     * @param prev_mix_volumes - Previous volumes of the skipped mix.
+     * @param voice_state      - State holding the depop samples of the voice.
+     * @param buffer_count     - Number of active mix buffers of the skipped mix.
+     */
+    void ClearVoiceMixSamples(std::span<const f32> mix_volumes,
+                              std::span<const f32> prev_mix_volumes, VoiceState& voice_state,
+                              s16 buffer_count);
+
     /**
      * Generate a biquad filter command for a voice.
      *
@@ -151,13 +166,27 @@ public:
     void GenerateBiquadFilterCommandForVoice(VoiceInfo& voice_info, const VoiceState& voice_state,
                                              s16 buffer_count, s8 channel, s32 node_id);
 
+    /**
+     * Check if a voice channel would only mix silence into its destinations, either because the
+     * voice volume stays at zero, or because every destination volume does.
+     *
+     * @param voice_info       - Voice info to check.
+     * @param channel_resource - Channel resource holding the mix volumes of this channel.
+     * @param channel          - Channel index to check.
+     * @return True if the mixing commands of this channel can be skipped.
+     */
+    bool IsVoiceChannelSilent(const VoiceInfo& voice_info,
+                              const VoiceChannelResource& channel_resource, s8 channel);
+
     /**
      * Generate commands for a voice.
      * Includes a data source, biquad filter, volume and mixing.
+     * Channels which would only mix silence skip their volume and mixing commands.
      *
      * @param voice_info - Voice info these commands are generated from.
+     * @return True if every channel of the voice was culled.
      */
-    void GenerateVoiceCommand(VoiceInfo& voice_info);
+    bool GenerateVoiceCommand(VoiceInfo& voice_info);
 
     /**
      * Generate commands for all voices.
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "audio_core/renderer/command/data_source/decode.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+#include "core/guest_memory.h"
+
+namespace AudioCore::Renderer {
+
+constexpr u32 AdpcmSamplesPerFrame{14};
+constexpr u32 AdpcmNibblesPerFrame{16};
+constexpr u32 AdpcmBytesPerFrame{AdpcmNibblesPerFrame / 2};
+/// Longest wave buffer, in samples, kept in the ADPCM decode cache
+constexpr u32 AdpcmCacheMaxSamples{0x10000};
+
+/**
+ * Decode ADPCM samples from encoded frames.
+ *
+ * @param out_buffer   - Output buffer to receive the samples.
+ * @param wavebuffer   - Encoded frames, beginning at the byte holding the first sample.
+ * @param start_pos    - Position of the first sample in the wavebuffer.
+ * @param count        - Number of samples to decode.
+ * @param coefficients - Predictor coefficients.
+ * @param context      - Decoder state, updated to the state after the last sample.
+ */
+void DecodeAdpcmSamples(std::span<s16> out_buffer, const u8* wavebuffer, u32 start_pos, u32 count,
+                        const std::array<s16, 16>& coefficients,
+                        VoiceState::AdpcmContext& context);
+
+/**
+ * Get the offset of the frame holding a sample.
+ *
+ * @param sample - Position of the sample in the wavebuffer.
+ * @return Byte offset of the frame's header in the wavebuffer.
+ */
+constexpr u64 GetAdpcmFrameOffset(u32 sample) {
+    return u64{sample / AdpcmSamplesPerFrame} * AdpcmBytesPerFrame;
+}
+
+/**
+ * Decode the whole wavebuffer range of a request into a voice's cache entry.
+ * Decoding starts from the request's current context, as it would without the cache.
+ *
+ * @param memory - Memory to read the encoded frames from.
+ * @param req    - Information for how to decode, the request must be at the range's start.
+ * @param cache  - Cache to store the samples in.
+ * @param entry  - The voice's entry.
+ */
+template <typename Memory>
+void CacheAdpcm(Memory& memory, const DecodeArg& req, AdpcmDecodeCache& cache,
+                AdpcmDecodeCache::Entry& entry) {
+    const u32 count{req.end_offset - req.start_offset};
+    const u64 data_start{GetAdpcmFrameOffset(req.start_offset)};
+    const u64 data_end{std::min(GetAdpcmFrameOffset(req.end_offset - 1) + AdpcmBytesPerFrame,
+                                req.buffer_size)};
+
+    std::vector<u8> data(data_end - data_start);
+    memory.ReadBlockUnsafe(req.buffer + data_start, data.data(), data.size());
+
+    // Headers selecting coefficients past the 8 pairs read outside of the coefficient table,
+    // those frames are not deterministic and are always decoded from guest memory
+    for (size_t header = 0; header < data.size(); header += AdpcmBytesPerFrame) {
+        if (static_cast<size_t>(data[header] >> 4) >= req.coefficients.size() / 2) {
+            cache.Release(entry);
+            return;
+        }
+    }
+
+    auto context{*req.adpcm_context};
+    std::vector<s16> samples(count + 2);
+    samples[0] = context.yn1;
+    samples[1] = context.yn0;
+    DecodeAdpcmSamples({samples.data() + 2, count}, data.data(), req.start_offset, count,
+                       req.coefficients, context);
+
+    entry.coefficients = req.coefficients;
+    cache.Store(entry, std::move(data), std::move(samples));
+}
+
+/**
+ * Decode ADPCM samples from a voice's cache entry.
+ * This only succeeds if the entry holds the samples with the same decoder state and encoded
+ * frames as the ones in guest memory.
+ *
+ * @param memory     - Memory to read the encoded frames from.
+ * @param out_buffer - Output mix buffer to receive the samples.
+ * @param req        - Information for how to decode.
+ * @param start_pos  - Position of the first sample in the wavebuffer.
+ * @param count      - Number of samples to decode.
+ * @param entry      - The voice's entry.
+ * @return True if the samples were taken from the cache.
+ */
+template <typename Memory>
+bool DecodeAdpcmCached(Memory& memory, std::span<s16> out_buffer, const DecodeArg& req,
+                       u32 start_pos, u32 count, const AdpcmDecodeCache::Entry& entry) {
+    if (entry.samples.empty() || entry.buffer != req.buffer || start_pos < entry.start_offset ||
+        start_pos + count > entry.end_offset || entry.coefficients != req.coefficients) {
+        return false;
+    }
+
+    auto& context{*req.adpcm_context};
+    const u32 index{start_pos - entry.start_offset};
+    if (context.yn1 != entry.samples[index] || context.yn0 != entry.samples[index + 1]) {
+        return false;
+    }
+
+    // Decoding from the middle of a frame continues with the header of the context
+    const u64 entry_start{GetAdpcmFrameOffset(entry.start_offset)};
+    const u64 first_frame{GetAdpcmFrameOffset(start_pos) - entry_start};
+    const u64 last_frame{GetAdpcmFrameOffset(start_pos + count - 1) - entry_start};
+    if (start_pos % AdpcmSamplesPerFrame != 0 && context.header != entry.data[first_frame]) {
+        return false;
+    }
+
+    const u64 data_end{std::min<u64>(last_frame + AdpcmBytesPerFrame, entry.data.size())};
+    Core::Memory::GuestMemory<Memory, u8, Core::Memory::GuestMemoryFlags::UnsafeRead> frames(
+        memory, req.buffer + entry_start + first_frame, data_end - first_frame);
+    if (std::memcmp(frames.data(), entry.data.data() + first_frame, frames.size()) != 0) {
+        return false;
+    }
+
+    std::memcpy(out_buffer.data(), entry.samples.data() + index + 2, count * sizeof(s16));
+    context.header = entry.data[last_frame];
+    context.yn0 = entry.samples[index + count + 1];
+    context.yn1 = entry.samples[index + count];
+    return true;
+}
+
+/**
+ * Decode ADPCM data.
+ * Memory is Core::Memory::Memory for the renderer, any type providing its GetSpan and
+ * ReadBlockUnsafe can be used to decode from other buffers.
+ *
+ * @param memory     - Memory to read the encoded frames from.
+ * @param out_buffer - Output mix buffer to receive the samples.
+ * @param req        - Information for how to decode.
+ * @param cache      - Decode cache, may be null.
+ * @param entry      - The voice's entry in the decode cache, may be null.
+ * @return Number of samples decoded.
+ */
+template <typename Memory>
+u32 DecodeAdpcm(Memory& memory, std::span<s16> out_buffer, const DecodeArg& req,
+                AdpcmDecodeCache* cache, AdpcmDecodeCache::Entry* entry) {
+    if (req.buffer == 0 || req.buffer_size == 0) {
+        return 0;
+    }
+
+    if (req.end_offset < req.start_offset) {
+        return 0;
+    }
+
+    auto end{(req.end_offset % AdpcmSamplesPerFrame) +
+             AdpcmNibblesPerFrame * (req.end_offset / AdpcmSamplesPerFrame)};
+    if (req.end_offset % AdpcmSamplesPerFrame) {
+        end += 3;
+    } else {
+        end += 1;
+    }
+
+    if (req.buffer_size < end / 2) {
+        return 0;
+    }
+
+    auto start_pos{req.start_offset + req.offset};
+    auto samples_to_process{std::min(req.end_offset - start_pos, req.samples_to_read)};
+    if (samples_to_process == 0) {
+        return 0;
+    }
+
+    if (cache && entry) {
+        const bool same_range{entry->buffer == req.buffer &&
+                              entry->start_offset == req.start_offset &&
+                              entry->end_offset == req.end_offset};
+        if (same_range &&
+            DecodeAdpcmCached(memory, out_buffer, req, start_pos, samples_to_process, *entry)) {
+            return samples_to_process;
+        }
+
+        // Short wavebuffers are decoded whole into the cache when they are started a second
+        // time, loops and sounds played repeatedly then copy the decoded samples
+        if (req.offset == 0 && !same_range) {
+            cache->Release(*entry);
+            entry->buffer = req.buffer;
+            entry->start_offset = req.start_offset;
+            entry->end_offset = req.end_offset;
+        } else if (req.offset == 0 && req.start_offset % AdpcmSamplesPerFrame == 0 &&
+                   req.end_offset - req.start_offset <= AdpcmCacheMaxSamples) {
+            CacheAdpcm(memory, req, *cache, *entry);
+            if (DecodeAdpcmCached(memory, out_buffer, req, start_pos, samples_to_process,
+                                  *entry)) {
+                return samples_to_process;
+            }
+        }
+    }
+
+    auto position_in_frame{(start_pos / AdpcmSamplesPerFrame) * AdpcmNibblesPerFrame +
+                           start_pos % AdpcmSamplesPerFrame};
+    if (start_pos % AdpcmSamplesPerFrame) {
+        position_in_frame += 2;
+    }
+
+    const auto size{std::max((samples_to_process / 8U) * AdpcmSamplesPerFrame, 8U)};
+    Core::Memory::GuestMemory<Memory, u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
+        memory, req.buffer + position_in_frame / 2, size);
+
+    DecodeAdpcmSamples(out_buffer, wavebuffer.data(), start_pos, samples_to_process,
+                       req.coefficients, *req.adpcm_context);
+
+    return samples_to_process;
+}
+
+} // namespace AudioCore::Renderer
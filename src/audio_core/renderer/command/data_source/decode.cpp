@@ -1,9 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <vector>
 
+#include "audio_core/renderer/command/data_source/adpcm_decode.h"
 #include "audio_core/renderer/command/data_source/decode.h"
 #include "audio_core/renderer/command/resample/resample.h"
 #include "common/fixed_point.h"
@@ -17,141 +20,53 @@ namespace AudioCore::Renderer {
 constexpr u32 TempBufferSize = 0x3F00;
 constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 
-/**
- * Decode PCM data. Only s16 or f32 is supported.
- *
- * @tparam T         - Type to decode. Only s16 and f32 are supported.
- * @param memory     - Core memory for reading samples.
- * @param out_buffer - Output mix buffer to receive the samples.
- * @param req        - Information for how to decode.
- * @return Number of samples decoded.
- */
-template <typename T>
-static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
-                     const DecodeArg& req) {
-    constexpr s32 min{std::numeric_limits<s16>::min()};
-    constexpr s32 max{std::numeric_limits<s16>::max()};
-
-    if (req.buffer == 0 || req.buffer_size == 0) {
-        return 0;
-    }
-
-    if (req.start_offset >= req.end_offset) {
-        return 0;
-    }
-
-    auto samples_to_decode{
-        std::min(req.samples_to_read, req.end_offset - req.start_offset - req.offset)};
-    u32 channel_count{static_cast<u32>(req.channel_count)};
-
-    switch (req.channel_count) {
-    default: {
-        const VAddr source{req.buffer +
-                           (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
-        const u64 size{channel_count * samples_to_decode};
-
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, size);
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                out_buffer[i] = samples[i * channel_count + req.target_channel];
-            }
-        }
-    } break;
-
-    case 1:
-        if (req.target_channel != 0) {
-            LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}",
-                      req.target_channel);
-            return 0;
-        }
-
-        const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, samples_to_decode);
+AdpcmDecodeCache::Entry& AdpcmDecodeCache::GetEntry(const VoiceState* voice_state) {
+    return entries[voice_state];
+}
 
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
+void AdpcmDecodeCache::Store(Entry& entry, std::vector<u8>&& data, std::vector<s16>&& samples) {
+    Release(entry);
+    const size_t size{data.size() + samples.size() * sizeof(s16)};
+    if (cache_size + size > MaxCacheSize) {
+        for (auto& [voice_state, other] : entries) {
+            Release(other);
         }
-        break;
     }
-
-    return samples_to_decode;
+    entry.data = std::move(data);
+    entry.samples = std::move(samples);
+    cache_size += size;
 }
 
-/**
- * Decode ADPCM data.
- *
- * @param memory     - Core memory for reading samples.
- * @param out_buffer - Output mix buffer to receive the samples.
- * @param req        - Information for how to decode.
- * @return Number of samples decoded.
- */
-static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
-                       const DecodeArg& req) {
-    constexpr u32 SamplesPerFrame{14};
-    constexpr u32 NibblesPerFrame{16};
-
-    if (req.buffer == 0 || req.buffer_size == 0) {
-        return 0;
-    }
-
-    if (req.end_offset < req.start_offset) {
-        return 0;
-    }
-
-    auto end{(req.end_offset % SamplesPerFrame) +
-             NibblesPerFrame * (req.end_offset / SamplesPerFrame)};
-    if (req.end_offset % SamplesPerFrame) {
-        end += 3;
-    } else {
-        end += 1;
-    }
-
-    if (req.buffer_size < end / 2) {
-        return 0;
-    }
+void AdpcmDecodeCache::Release(Entry& entry) {
+    cache_size -= GetSize(entry);
+    entry.data = {};
+    entry.samples = {};
+}
 
-    auto start_pos{req.start_offset + req.offset};
-    auto samples_to_process{std::min(req.end_offset - start_pos, req.samples_to_read)};
-    if (samples_to_process == 0) {
-        return 0;
-    }
+size_t AdpcmDecodeCache::GetSize(const Entry& entry) {
+    return entry.data.size() + entry.samples.size() * sizeof(s16);
+}
 
-    auto samples_to_read{samples_to_process};
-    auto samples_remaining_in_frame{start_pos % SamplesPerFrame};
-    auto position_in_frame{(start_pos / SamplesPerFrame) * NibblesPerFrame +
+void DecodeAdpcmSamples(std::span<s16> out_buffer, const u8* wavebuffer, u32 start_pos, u32 count,
+                        const std::array<s16, 16>& coefficients,
+                        VoiceState::AdpcmContext& context) {
+    auto samples_to_read{count};
+    auto samples_remaining_in_frame{start_pos % AdpcmSamplesPerFrame};
+    auto position_in_frame{(start_pos / AdpcmSamplesPerFrame) * AdpcmNibblesPerFrame +
                            samples_remaining_in_frame};
 
     if (samples_remaining_in_frame) {
         position_in_frame += 2;
     }
 
-    const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
-    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
-        memory, req.buffer + position_in_frame / 2, size);
-
-    auto context{req.adpcm_context};
-    auto header{context->header};
+    auto header{context.header};
     u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
     u8 scale{static_cast<u8>(header & 0xFU)};
-    s32 coeff0{req.coefficients[coeff_index * 2 + 0]};
-    s32 coeff1{req.coefficients[coeff_index * 2 + 1]};
+    s32 coeff0{coefficients[coeff_index * 2 + 0]};
+    s32 coeff1{coefficients[coeff_index * 2 + 1]};
 
-    auto yn0{context->yn0};
-    auto yn1{context->yn1};
+    auto yn0{context.yn0};
+    auto yn1{context.yn1};
 
     static constexpr std::array<s32, 16> Steps{
         0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
@@ -172,18 +87,18 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
 
     while (samples_to_read > 0) {
         // Are we at a new frame?
-        if ((position_in_frame % NibblesPerFrame) == 0) {
+        if ((position_in_frame % AdpcmNibblesPerFrame) == 0) {
             header = wavebuffer[read_index++];
             coeff_index = (header >> 4) & 0xF;
             scale = header & 0xF;
-            coeff0 = req.coefficients[coeff_index * 2 + 0];
-            coeff1 = req.coefficients[coeff_index * 2 + 1];
+            coeff0 = coefficients[coeff_index * 2 + 0];
+            coeff1 = coefficients[coeff_index * 2 + 1];
             position_in_frame += 2;
 
             // Can we consume all of this frame's samples?
-            if (samples_to_read >= SamplesPerFrame) {
+            if (samples_to_read >= AdpcmSamplesPerFrame) {
                 // Can grab all samples until the next header
-                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
+                for (u32 i = 0; i < AdpcmSamplesPerFrame / 2; i++) {
                     auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
                     auto code1{Steps[wavebuffer[read_index] & 0xF]};
                     read_index++;
@@ -192,8 +107,8 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                     out_buffer[write_index++] = decode_sample(code1);
                 }
 
-                position_in_frame += SamplesPerFrame;
-                samples_to_read -= SamplesPerFrame;
+                position_in_frame += AdpcmSamplesPerFrame;
+                samples_to_read -= AdpcmSamplesPerFrame;
                 continue;
             }
         }
@@ -213,11 +128,86 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         samples_to_read--;
     }
 
-    context->header = header;
-    context->yn0 = yn0;
-    context->yn1 = yn1;
+    context.header = header;
+    context.yn0 = yn0;
+    context.yn1 = yn1;
+}
 
-    return samples_to_process;
+/**
+ * Decode PCM data. Only s16 or f32 is supported.
+ *
+ * @tparam T         - Type to decode. Only s16 and f32 are supported.
+ * @param memory     - Core memory for reading samples.
+ * @param out_buffer - Output mix buffer to receive the samples.
+ * @param req        - Information for how to decode.
+ * @return Number of samples decoded.
+ */
+template <typename T>
+static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
+                     const DecodeArg& req) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+
+    if (req.buffer == 0 || req.buffer_size == 0) {
+        return 0;
+    }
+
+    if (req.start_offset >= req.end_offset) {
+        return 0;
+    }
+
+    auto samples_to_decode{
+        std::min(req.samples_to_read, req.end_offset - req.start_offset - req.offset)};
+    u32 channel_count{static_cast<u32>(req.channel_count)};
+
+    switch (req.channel_count) {
+    default: {
+        const VAddr source{req.buffer +
+                           (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
+        const u64 size{channel_count * samples_to_decode};
+
+        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+            memory, source, size);
+        const T* const input{samples.data() + req.target_channel};
+        if constexpr (std::is_floating_point_v<T>) {
+            for (u32 i = 0; i < samples_to_decode; i++) {
+                auto sample{static_cast<s32>(input[i * channel_count] *
+                                             std::numeric_limits<s16>::max())};
+                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
+            }
+        } else {
+            for (u32 i = 0; i < samples_to_decode; i++) {
+                out_buffer[i] = input[i * channel_count];
+            }
+        }
+    } break;
+
+    case 1:
+        if (req.target_channel != 0) {
+            LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}",
+                      req.target_channel);
+            return 0;
+        }
+
+        const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
+        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+            memory, source, samples_to_decode);
+
+        if constexpr (std::is_floating_point_v<T>) {
+            // Contiguous input and output, written so that the conversion is vectorized
+            const T* const input{samples.data()};
+            s16* const output{out_buffer.data()};
+            for (u32 i = 0; i < samples_to_decode; i++) {
+                const auto sample{static_cast<s32>(input[i] * std::numeric_limits<s16>::max())};
+                output[i] = static_cast<s16>(std::clamp(sample, min, max));
+            }
+        } else {
+            std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
+        }
+        break;
+    }
+
+    return samples_to_decode;
 }
 
 /**
@@ -272,6 +262,11 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     auto output_buffer{args.output};
     std::array<s16, TempBufferSize> temp_buffer{};
 
+    AdpcmDecodeCache::Entry* adpcm_cache_entry{nullptr};
+    if (args.adpcm_cache && args.sample_format == SampleFormat::Adpcm) {
+        adpcm_cache_entry = &args.adpcm_cache->GetEntry(&voice_state);
+    }
+
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
         const auto samples_to_read{
@@ -350,7 +345,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
                 memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
                 samples_decoded = DecodeAdpcm(
                     memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
-                    decode_arg);
+                    decode_arg, args.adpcm_cache, adpcm_cache_entry);
             } break;
 
             default:
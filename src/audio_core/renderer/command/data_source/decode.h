@@ -5,6 +5,8 @@
 
 #include <array>
 #include <span>
+#include <unordered_map>
+#include <vector>
 
 #include "audio_core/common/common.h"
 #include "audio_core/common/wave_buffer.h"
@@ -17,6 +19,60 @@ class Memory;
 
 namespace AudioCore::Renderer {
 
+/**
+ * Decoded samples of short ADPCM wave buffers, kept per voice so that sounds which loop or are
+ * played repeatedly are only decoded once. Cached samples are only used while the encoded frames
+ * and the decoder state match the ones they were decoded from, so the output is the same as if
+ * they were decoded again.
+ */
+class AdpcmDecodeCache {
+public:
+    struct Entry {
+        /// Wavebuffer range last started on the voice
+        CpuAddr buffer;
+        u32 start_offset;
+        u32 end_offset;
+        /// Coefficients the samples were decoded with
+        std::array<s16, 16> coefficients;
+        /// Encoded frames, beginning with the frame holding start_offset
+        std::vector<u8> data;
+        /// Decoder history at start_offset (yn1, yn0), followed by the decoded samples
+        std::vector<s16> samples;
+    };
+
+    /**
+     * Get the cache entry of a voice.
+     *
+     * @param voice_state - State of the voice.
+     * @return The voice's entry.
+     */
+    Entry& GetEntry(const VoiceState* voice_state);
+
+    /**
+     * Store decoded samples in an entry, evicting the other entries if the cache is full.
+     *
+     * @param entry   - Entry to store the samples in.
+     * @param data    - Encoded frames the samples were decoded from.
+     * @param samples - Decoder history followed by the decoded samples.
+     */
+    void Store(Entry& entry, std::vector<u8>&& data, std::vector<s16>&& samples);
+
+    /**
+     * Drop the samples of an entry.
+     *
+     * @param entry - Entry to release.
+     */
+    void Release(Entry& entry);
+
+private:
+    static constexpr size_t MaxCacheSize = 16 * 1024 * 1024;
+
+    static size_t GetSize(const Entry& entry);
+
+    std::unordered_map<const VoiceState*, Entry> entries;
+    size_t cache_size{};
+};
+
 struct DecodeFromWaveBuffersArgs {
     SampleFormat sample_format;
     std::span<s32> output;
@@ -33,6 +89,7 @@ struct DecodeFromWaveBuffersArgs {
     u64 data_size;
     bool IsVoicePlayedSampleCountResetAtLoopPointSupported;
     bool IsVoicePitchAndSrcSkippedSupported;
+    AdpcmDecodeCache* adpcm_cache;
 };
 
 struct DecodeArg {
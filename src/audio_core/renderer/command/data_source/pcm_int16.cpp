@@ -45,6 +45,7 @@ void PcmInt16DataSourceVersion1Command::Process(
         .data_size{0},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .adpcm_cache{nullptr},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
@@ -84,6 +85,7 @@ void PcmInt16DataSourceVersion2Command::Process(
         .data_size{0},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .adpcm_cache{nullptr},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
@@ -359,6 +359,8 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
     drop_voice = params.voice_drop_enabled && params.execution_mode == ExecutionMode::Auto;
     drop_voice_param = 1.0f;
     num_voices_dropped = 0;
+    num_voices_rendered = 0;
+    num_voices_culled = 0;
 
     allocator.Align(0x40);
     command_workbuffer_size = allocator.GetRemainingSize();
@@ -407,6 +409,15 @@ void System::Finalize() {
         Stop();
     }
 
+    if (num_voices_rendered > 0) {
+        LOG_DEBUG(Service_Audio,
+                  "Session {} rendered {} voices over {} command lists, {} ({:.1f}%) culled as "
+                  "silent",
+                  session_id, num_voices_rendered, num_command_lists_generated, num_voices_culled,
+                  100.0 * static_cast<f64>(num_voices_culled) /
+                      static_cast<f64>(num_voices_rendered));
+    }
+
     applet_resource_user_id = 0;
 
     PoolMapper pool_mapper(process_handle, false);
@@ -689,6 +700,8 @@ u64 System::GenerateCommand(std::span<u8> in_command_buffer,
 
     voice_context.SortInfo();
     command_generator.GenerateVoiceCommands();
+    num_voices_rendered += voice_context.GetRenderedCount();
+    num_voices_culled += voice_context.GetCulledCount();
 
     const auto start_estimated_time{drop_voice_param *
                                     static_cast<f32>(command_buffer.estimated_process_time)};
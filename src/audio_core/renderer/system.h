@@ -319,6 +319,10 @@ private:
     bool adsp_behind{};
     /// Number of voices dropped
     u32 num_voices_dropped{};
+    /// Total number of voices which generated commands, summed over every command list
+    u64 num_voices_rendered{};
+    /// Total number of rendered voices which were culled for being silent
+    u64 num_voices_culled{};
     /// Tick that rendering started
     u64 render_start_tick{};
     /// Parameter to control the threshold for dropping voices if the audio graph gets too large
@@ -34,6 +34,9 @@ void VoiceContext::Initialize(std::span<VoiceInfo*> sorted_voice_infos_,
     dsp_states = dsp_states_;
     voice_count = voice_count_;
     active_count = 0;
+    rendered_count = 0;
+    culled_count = 0;
+    sorted_valid = false;
 }
 
 VoiceInfo* VoiceContext::GetSortedInfo(const u32 index) {
@@ -69,15 +72,52 @@ void VoiceContext::SetActiveCount(const u32 active_count_) {
     active_count = active_count_;
 }
 
-void VoiceContext::SortInfo() {
-    for (u32 i = 0; i < voice_count; i++) {
-        sorted_voice_info[i] = &voices[i];
-    }
+u32 VoiceContext::GetRenderedCount() const {
+    return rendered_count;
+}
 
-    std::ranges::sort(sorted_voice_info, [](const VoiceInfo* a, const VoiceInfo* b) {
+u32 VoiceContext::GetCulledCount() const {
+    return culled_count;
+}
+
+void VoiceContext::SetRenderedCounts(const u32 rendered_count_, const u32 culled_count_) {
+    rendered_count = rendered_count_;
+    culled_count = culled_count_;
+}
+
+void VoiceContext::SortInfo() {
+    const auto compare{[](const VoiceInfo* a, const VoiceInfo* b) {
         return a->priority != b->priority ? a->priority > b->priority
                                           : a->sort_order > b->sort_order;
-    });
+    }};
+
+    if (!sorted_valid) {
+        for (u32 i = 0; i < voice_count; i++) {
+            sorted_voice_info[i] = &voices[i];
+        }
+        std::ranges::sort(sorted_voice_info, compare);
+        sorted_valid = true;
+        return;
+    }
+
+    // Priorities rarely change between updates, so the previous order is almost sorted already.
+    // Insertion sort fixes it up in linear time, a full sort is used once too many voices moved.
+    const u64 max_moves{static_cast<u64>(voice_count) * 8};
+    u64 moves{0};
+    for (u32 i = 1; i < voice_count; i++) {
+        auto voice{sorted_voice_info[i]};
+        u32 j{i};
+        for (; j > 0 && compare(voice, sorted_voice_info[j - 1]); j--) {
+            sorted_voice_info[j] = sorted_voice_info[j - 1];
+        }
+        sorted_voice_info[j] = voice;
+
+        moves += i - j;
+        if (moves > max_moves) {
+            std::ranges::sort(sorted_voice_info, compare);
+            return;
+        }
+    }
 }
 
 void VoiceContext::UpdateStateByDspShared() {
@@ -95,9 +95,33 @@ public:
      */
     void SetActiveCount(u32 active_count);
 
+    /**
+     * Get the number of voices which generated commands during the last update.
+     *
+     * @return The number of rendered voices.
+     */
+    u32 GetRenderedCount() const;
+
+    /**
+     * Get the number of rendered voices which were culled during the last update, as every
+     * channel would only have mixed silence.
+     *
+     * @return The number of culled voices.
+     */
+    u32 GetCulledCount() const;
+
+    /**
+     * Set the voice counts of the last update.
+     *
+     * @param rendered_count - The number of voices which generated commands.
+     * @param culled_count   - The number of those voices which were culled.
+     */
+    void SetRenderedCounts(u32 rendered_count, u32 culled_count);
+
     /**
      * Sort all voices. Results are available via GetSortedInfo.
      * Voices are sorted descendingly, according to priority, and then sort order.
+     * The order of the previous sort is reused, so only voices whose priority changed move.
      */
     void SortInfo();
 
@@ -121,6 +145,12 @@ private:
     u32 voice_count{};
     /// Number of active voices
     u32 active_count{};
+    /// Number of voices which generated commands in the last update
+    u32 rendered_count{};
+    /// Number of rendered voices which were culled in the last update
+    u32 culled_count{};
+    /// Does sorted_voice_info hold the order of a previous sort?
+    bool sorted_valid{};
 };
 
 } // namespace AudioCore::Renderer
@@ -209,6 +209,12 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
            tr("Enables asynchronous shader compilation, which may reduce shader stutter.\nThis "
               "feature "
               "is experimental."));
+    INSERT(Settings, async_shader_mode, tr("Pending shader behavior:"),
+           tr("Controls draws whose shaders are still being built asynchronously.\nWait blocks "
+              "until the shader is ready.\nBudgeted waits up to the per-frame budget, then skips "
+              "the draw.\nSkip never waits."));
+    INSERT(Settings, async_shader_wait_budget, tr("Shader wait budget (ms per frame):"),
+           tr("Maximum time per frame spent waiting for shaders in Budgeted mode."));
     INSERT(Settings, use_fast_gpu_time, tr("Use Fast GPU Time (Hack)"),
            tr("Enables Fast GPU Time. This option will force most games to run at their highest "
               "native resolution."));
@@ -346,6 +352,12 @@ std::unique_ptr<ComboboxTranslationMap> ComboboxEnumeration(QWidget* parent) {
                               PAIR(VramUsageMode, HighEnd, tr("High-End GPU (4090/4080+)")),
                               PAIR(VramUsageMode, Insane, tr("Insane (RTX 4090 24GB)")),
                           }});
+    translations->insert({Settings::EnumMetadata<Settings::AsyncShaderMode>::Index(),
+                          {
+                              PAIR(AsyncShaderMode, Wait, tr("Wait")),
+                              PAIR(AsyncShaderMode, Budgeted, tr("Budgeted")),
+                              PAIR(AsyncShaderMode, Skip, tr("Skip")),
+                          }});
     translations->insert({Settings::EnumMetadata<Settings::ExtendedDynamicState>::Index(),
                           {
                               PAIR(ExtendedDynamicState, Disabled, tr("Disabled")),
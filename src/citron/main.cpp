@@ -2731,18 +2731,22 @@ void GMainWindow::RemoveTransferableShaderCache(u64 program_id, GameListRemoveTa
 }
 
 void GMainWindow::RemoveVulkanDriverPipelineCache(u64 program_id) {
-    static constexpr std::string_view target_file_name = "vulkan_pipelines.bin";
+    // Older versions wrote the driver cache without a checksum to vulkan_pipelines.bin
+    static constexpr std::array<std::string_view, 2> target_file_names{
+        "vulkan_driver_pipelines.bin", "vulkan_pipelines.bin"};
 
     const auto shader_cache_dir = Common::FS::GetCitronPath(Common::FS::CitronPath::ShaderDir);
     const auto shader_cache_folder_path = shader_cache_dir / fmt::format("{:016x}", program_id);
-    const auto target_file = shader_cache_folder_path / target_file_name;
 
-    if (!Common::FS::Exists(target_file)) {
-        return;
-    }
-    if (!Common::FS::RemoveFile(target_file)) {
-        QMessageBox::warning(this, tr("Error Removing Vulkan Driver Pipeline Cache"),
-                             tr("Failed to remove the driver pipeline cache."));
+    for (const std::string_view target_file_name : target_file_names) {
+        const auto target_file = shader_cache_folder_path / target_file_name;
+        if (!Common::FS::Exists(target_file)) {
+            continue;
+        }
+        if (!Common::FS::RemoveFile(target_file)) {
+            QMessageBox::warning(this, tr("Error Removing Vulkan Driver Pipeline Cache"),
+                                 tr("Failed to remove the driver pipeline cache."));
+        }
     }
 }
 
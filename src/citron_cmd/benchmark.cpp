@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdio>
+#include <map>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#ifdef __linux__
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#endif
+
+#include "common/fiber.h"
+#include "common/fs/file.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "input_common/drivers/tas_input.h"
+#include "citron_cmd/benchmark.h"
+
+namespace {
+// 2020-01-01 00:00:00 UTC, any fixed value works as long as it is the same between runs
+constexpr s64 BenchmarkRtc = 1577836800;
+
+/// Host CPU time spent by each named thread, threads with the same name are added together
+std::map<std::string, double> GetThreadCpuSeconds() {
+    std::map<std::string, double> cpu_seconds;
+#ifdef __linux__
+    const double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+    std::error_code ec;
+    for (const auto& task : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+        std::string name;
+        std::getline(std::ifstream{task.path() / "comm"}, name);
+
+        std::string stat;
+        std::getline(std::ifstream{task.path() / "stat"}, stat);
+        // The thread name in the stat line may contain spaces, fields are parsed after it
+        const auto name_end = stat.rfind(')');
+        if (name.empty() || name_end == std::string::npos) {
+            continue;
+        }
+        std::istringstream fields{stat.substr(name_end + 2)};
+        std::string field;
+        // utime and stime are the 14th and 15th fields, the 12th and 13th after the name
+        for (int i = 0; i < 11; ++i) {
+            fields >> field;
+        }
+        u64 user_ticks{};
+        u64 system_ticks{};
+        fields >> user_ticks >> system_ticks;
+        cpu_seconds[name] += static_cast<double>(user_ticks + system_ticks) / ticks_per_second;
+    }
+#endif
+    return cpu_seconds;
+}
+
+std::string EscapeJson(std::string_view string) {
+    std::string escaped;
+    escaped.reserve(string.size());
+    for (const char c : string) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        if (static_cast<unsigned char>(c) >= 0x20) {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+} // Anonymous namespace
+
+void ApplyBenchmarkSettings() {
+    auto& values = Settings::values;
+    values.use_multi_core.SetValue(false);
+    values.use_speed_limit.SetValue(false);
+    values.renderer_backend.SetValue(Settings::RendererBackend::Null);
+    values.sink_id.SetValue(Settings::AudioEngine::Null);
+    values.use_disk_shader_cache.SetValue(false);
+    values.rng_seed_enabled.SetValue(true);
+    values.rng_seed.SetValue(0);
+    values.custom_rtc_enabled.SetValue(true);
+    values.custom_rtc.SetValue(BenchmarkRtc);
+    values.tas_enable.SetValue(true);
+    values.tas_loop.SetValue(false);
+    values.pause_tas_on_load.SetValue(false);
+}
+
+BenchmarkSession::BenchmarkSession(Core::System& system_, u64 frame_limit_,
+                                   std::string report_path_)
+    : system{system_}, frame_limit{frame_limit_}, report_path{std::move(report_path_)} {}
+
+void BenchmarkSession::Start(InputCommon::TasInput::Tas& tas) {
+    tas.Reset();
+    tas.StartStop();
+    start_time = Clock::now();
+}
+
+bool BenchmarkSession::OnFrameDisplayed(const InputCommon::TasInput::Tas& tas) {
+    if (is_finished) {
+        return true;
+    }
+    const u64 frame = ++frames;
+    const bool reached_limit = frame_limit != 0 && frame >= frame_limit;
+    const auto tas_state = std::get<0>(tas.GetStatus());
+    const bool script_finished =
+        frame_limit == 0 && tas_state == InputCommon::TasInput::TasState::Stopped;
+    if (!reached_limit && !script_finished) {
+        return false;
+    }
+    end_time = Clock::now();
+    is_finished = true;
+    return true;
+}
+
+void BenchmarkSession::WriteReport() {
+    if (!is_finished) {
+        end_time = Clock::now();
+    }
+    const double host_seconds = std::chrono::duration<double>(end_time - start_time).count();
+    const double guest_seconds =
+        std::chrono::duration<double>(system.CoreTiming().GetGlobalTimeUs()).count();
+    const u64 num_frames = frames.load();
+
+    std::string threads;
+    for (const auto& [name, cpu_seconds] : GetThreadCpuSeconds()) {
+        threads += fmt::format("{}\n    \"{}\": {:.3f}", threads.empty() ? "" : ",",
+                               EscapeJson(name), cpu_seconds);
+    }
+    const auto fibers = Common::Fiber::GetStatistics();
+    const std::string report = fmt::format(
+        "{{\n"
+        "  \"title_id\": \"{:016X}\",\n"
+        "  \"completed\": {},\n"
+        "  \"frames\": {},\n"
+        "  \"host_seconds\": {:.3f},\n"
+        "  \"guest_seconds\": {:.3f},\n"
+        "  \"frames_per_second\": {:.3f},\n"
+        "  \"thread_cpu_seconds\": {{{}\n  }},\n"
+        "  \"fibers\": {{\n"
+        "    \"live\": {},\n"
+        "    \"allocated_stacks\": {},\n"
+        "    \"pooled_stacks\": {},\n"
+        "    \"stack_bytes\": {}\n"
+        "  }}\n"
+        "}}\n",
+        system.GetApplicationProcessProgramID(), is_finished.load(), num_frames, host_seconds,
+        guest_seconds, host_seconds > 0.0 ? static_cast<double>(num_frames) / host_seconds : 0.0,
+        threads, fibers.live_fibers, fibers.allocated_stacks, fibers.pooled_stacks,
+        fibers.stack_memory);
+
+    if (report_path.empty()) {
+        std::fputs(report.c_str(), stdout);
+        return;
+    }
+    if (Common::FS::WriteStringToFile(report_path, Common::FS::FileType::TextFile, report) !=
+        report.size()) {
+        LOG_ERROR(Frontend, "Failed to write benchmark report to {}", report_path);
+    }
+}
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "common/common_types.h"
+
+namespace Core {
+class System;
+}
+
+namespace InputCommon::TasInput {
+class Tas;
+}
+
+/// Overrides the settings that make runs differ from each other: guest time is driven by cycle
+/// counting on a single core, the RNG seed and clock are fixed, rendering and audio output are
+/// disabled and input comes from the TAS scripts.
+void ApplyBenchmarkSettings();
+
+/// Replays the TAS scripts for a number of guest frames and reports how long it took.
+class BenchmarkSession {
+public:
+    /**
+     * @param frame_limit Number of frames to run, 0 runs until the TAS scripts finish
+     * @param report_path File to write the JSON report to, empty writes it to stdout
+     */
+    explicit BenchmarkSession(Core::System& system, u64 frame_limit, std::string report_path);
+
+    /// Starts TAS playback and the host timer, call right before the emulation starts running
+    void Start(InputCommon::TasInput::Tas& tas);
+
+    /// Counts a presented frame. Returns true when the benchmark has finished.
+    bool OnFrameDisplayed(const InputCommon::TasInput::Tas& tas);
+
+    /// Writes the report, must be called before the emulated process is shut down
+    void WriteReport();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Core::System& system;
+    const u64 frame_limit;
+    const std::string report_path;
+
+    std::atomic<u64> frames{};
+    std::atomic<bool> is_finished{};
+    Clock::time_point start_time{};
+    Clock::time_point end_time{};
+};
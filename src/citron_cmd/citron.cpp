@@ -31,10 +31,12 @@
 #include "core/loader/loader.h"
 #include "core/telemetry_session.h"
 #include "frontend_common/config.h"
+#include "input_common/drivers/tas_input.h"
 #include "input_common/main.h"
 #include "network/network.h"
 #include "sdl_config.h"
 #include "video_core/renderer_base.h"
+#include "citron_cmd/benchmark.h"
 #include "citron_cmd/emu_window/emu_window_sdl2.h"
 #include "citron_cmd/emu_window/emu_window_sdl2_gl.h"
 #include "citron_cmd/emu_window/emu_window_sdl2_null.h"
@@ -71,6 +73,9 @@ __declspec(dllexport) int AmdPowerXpressRequestHighPerformance = 1;
 static void PrintHelp(const char* argv0) {
     std::cout << "Usage: " << argv0
               << " [options] <filename>\n"
+                 "-b, --benchmark=N     Replay the TAS scripts deterministically for N frames\n"
+                 "                      (until the scripts end if N is 0) and report timings\n"
+                 "    --benchmark-report=FILE  Write the benchmark report to FILE\n"
                  "-c, --config          Load the specified configuration file\n"
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-g, --game            File path of the game to load\n"
@@ -78,6 +83,7 @@ static void PrintHelp(const char* argv0) {
                  "-m, --multiplayer=nick:password@address:port"
                  " Nickname, password, address and port for multiplayer\n"
                  "-p, --program         Pass following string as arguments to executable\n"
+                 "-s, --shared-cache    Share read-only caches with other running instances\n"
                  "-u, --user            Select a specific user profile from 0 to 7\n"
                  "-v, --version         Output version information and exit\n";
 }
@@ -219,14 +225,21 @@ int main(int argc, char** argv) {
     std::string address{};
     u16 port = Network::DefaultRoomPort;
 
+    std::optional<u64> benchmark_frames;
+    std::string benchmark_report_path;
+    bool use_shared_cache = false;
+
     static struct option long_options[] = {
         // clang-format off
+        {"benchmark", required_argument, 0, 'b'},
+        {"benchmark-report", required_argument, 0, 'r'},
         {"config", required_argument, 0, 'c'},
         {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},
         {"game", required_argument, 0, 'g'},
         {"multiplayer", required_argument, 0, 'm'},
         {"program", optional_argument, 0, 'p'},
+        {"shared-cache", no_argument, 0, 's'},
         {"user", required_argument, 0, 'u'},
         {"version", no_argument, 0, 'v'},
         {0, 0, 0, 0},
@@ -234,9 +247,15 @@ int main(int argc, char** argv) {
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::c:u:", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "b:g:fhvp::c:su:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
+            case 'b':
+                benchmark_frames = std::strtoull(optarg, nullptr, 0);
+                break;
+            case 'r':
+                benchmark_report_path = optarg;
+                break;
             case 'c':
                 config_path = optarg;
                 break;
@@ -289,6 +308,9 @@ int main(int argc, char** argv) {
                 program_args = argv[optind];
                 ++optind;
                 break;
+            case 's':
+                use_shared_cache = true;
+                break;
             case 'u':
                 selected_user = atoi(optarg);
                 break;
@@ -322,6 +344,14 @@ int main(int argc, char** argv) {
         Settings::values.current_user = std::clamp(*selected_user, 0, 7);
     }
 
+    if (use_shared_cache) {
+        Settings::values.shared_cache = true;
+    }
+
+    if (benchmark_frames.has_value()) {
+        ApplyBenchmarkSettings();
+    }
+
 #ifdef _WIN32
     LocalFree(argv_w);
 #endif
@@ -435,6 +465,17 @@ int main(int argc, char** argv) {
         exit(0);
     });
 
+    std::optional<BenchmarkSession> benchmark;
+    if (benchmark_frames.has_value()) {
+        benchmark.emplace(system, *benchmark_frames, benchmark_report_path);
+        emu_window->SetFrameDisplayedCallback([&] {
+            if (benchmark->OnFrameDisplayed(*input_subsystem.GetTas())) {
+                emu_window->RequestClose();
+            }
+        });
+        benchmark->Start(*input_subsystem.GetTas());
+    }
+
 #ifdef __unix__
     Common::Linux::StartGamemode();
 #endif
@@ -448,6 +489,9 @@ int main(int argc, char** argv) {
     }
     system.DetachDebugger();
     void(system.Pause());
+    if (benchmark) {
+        benchmark->WriteReport();
+    }
     system.ShutdownMainProcess();
 
 #ifdef __unix__
@@ -12,6 +12,7 @@
 #include "hid_core/hid_core.h"
 #include "input_common/drivers/keyboard.h"
 #include "input_common/drivers/mouse.h"
+#include "input_common/drivers/tas_input.h"
 #include "input_common/drivers/touch_screen.h"
 #include "input_common/main.h"
 #include "citron_cmd/emu_window/emu_window_sdl2.h"
@@ -111,6 +112,23 @@ bool EmuWindow_SDL2::IsShown() const {
     return is_shown;
 }
 
+void EmuWindow_SDL2::RequestClose() {
+    SDL_Event event{};
+    event.type = SDL_QUIT;
+    SDL_PushEvent(&event);
+}
+
+void EmuWindow_SDL2::SetFrameDisplayedCallback(std::function<void()> callback) {
+    frame_displayed_callback = std::move(callback);
+}
+
+void EmuWindow_SDL2::OnFrameDisplayed() {
+    input_subsystem->GetTas()->UpdateThread();
+    if (frame_displayed_callback) {
+        frame_displayed_callback();
+    }
+}
+
 void EmuWindow_SDL2::OnResize() {
     int width, height;
     SDL_GL_GetDrawableSize(render_window, &width, &height);
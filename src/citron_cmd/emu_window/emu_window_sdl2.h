@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <utility>
 
 #include "core/frontend/emu_window.h"
@@ -37,6 +38,14 @@ public:
     // Sets the window icon from citron.bmp
     void SetWindowIcon();
 
+    /// Asks the main loop to close the window, can be called from any thread.
+    void RequestClose();
+
+    /// Sets a callback invoked from the render thread after every presented frame.
+    void SetFrameDisplayedCallback(std::function<void()> callback);
+
+    void OnFrameDisplayed() override;
+
 protected:
     /// Called by WaitEvent when a key is pressed or released.
     void OnKeyEvent(int key, u8 state);
@@ -94,6 +103,9 @@ protected:
 
     /// citron core instance
     Core::System& system;
+
+    /// Invoked after every presented frame
+    std::function<void()> frame_displayed_callback;
 };
 
 class DummyContext : public Core::Frontend::GraphicsContext {};
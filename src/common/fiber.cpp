@@ -1,9 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
 #include <mutex>
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
 #include "common/assert.h"
+#include "common/common_types.h"
 #include "common/fiber.h"
 #include "common/virtual_buffer.h"
 
@@ -12,12 +21,100 @@
 namespace Common {
 
 constexpr std::size_t default_stack_size = 512 * 1024;
+constexpr std::size_t stack_guard_size = 0x1000;
+constexpr std::size_t stack_allocation_size = default_stack_size + stack_guard_size;
+constexpr std::size_t max_pooled_stacks = 64;
+
+namespace {
+
+/**
+ * Recycles fiber stacks, so short-lived guest threads do not map and unmap a new stack each.
+ * Free stacks are kept in a fixed array of slots claimed with atomic exchanges, which makes the
+ * pool lock-free without being exposed to ABA issues.
+ * Every stack has an inaccessible guard page below it, overflowing it faults immediately instead
+ * of corrupting a neighbouring allocation.
+ */
+class FiberStackPool {
+public:
+    /// Returns the lowest usable address of a stack of default_stack_size bytes
+    u8* Acquire() {
+        for (auto& slot : slots) {
+            if (slot.load(std::memory_order_relaxed) == nullptr) {
+                continue;
+            }
+            if (u8* const stack = slot.exchange(nullptr, std::memory_order_acquire)) {
+                pooled_stacks.fetch_sub(1, std::memory_order_relaxed);
+                return stack;
+            }
+        }
+        return Allocate();
+    }
+
+    void Release(u8* stack) {
+        for (auto& slot : slots) {
+            u8* expected = nullptr;
+            if (slot.load(std::memory_order_relaxed) == nullptr &&
+                slot.compare_exchange_strong(expected, stack, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+                pooled_stacks.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+        Free(stack);
+    }
+
+    [[nodiscard]] std::size_t AllocatedStacks() const {
+        return allocated_stacks.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t PooledStacks() const {
+        return pooled_stacks.load(std::memory_order_relaxed);
+    }
+
+private:
+    u8* Allocate() {
+        auto* const base = static_cast<u8*>(AllocateMemoryPages(stack_allocation_size));
+#ifdef _WIN32
+        DWORD old_protect;
+        ASSERT(VirtualProtect(base, stack_guard_size, PAGE_NOACCESS, &old_protect));
+#else
+        ASSERT(mprotect(base, stack_guard_size, PROT_NONE) == 0);
+#endif
+        allocated_stacks.fetch_add(1, std::memory_order_relaxed);
+        return base + stack_guard_size;
+    }
+
+    void Free(u8* stack) {
+        FreeMemoryPages(stack - stack_guard_size, stack_allocation_size);
+        allocated_stacks.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<u8*>, max_pooled_stacks> slots{};
+    std::atomic<std::size_t> allocated_stacks{};
+    std::atomic<std::size_t> pooled_stacks{};
+};
+
+// Never destroyed, fibers may outlive other static objects. Pooled stacks are reclaimed with the
+// process.
+constinit FiberStackPool stack_pool;
+constinit std::atomic<std::size_t> live_fibers{};
+
+} // Anonymous namespace
 
 struct Fiber::FiberImpl {
-    FiberImpl() : stack{default_stack_size}, rewind_stack{default_stack_size} {}
+    FiberImpl() {
+        live_fibers.fetch_add(1, std::memory_order_relaxed);
+    }
 
-    VirtualBuffer<u8> stack;
-    VirtualBuffer<u8> rewind_stack;
+    ~FiberImpl() {
+        if (stack_limit != nullptr) {
+            stack_pool.Release(stack_limit);
+        }
+        if (rewind_stack_limit != nullptr) {
+            stack_pool.Release(rewind_stack_limit);
+        }
+        live_fibers.fetch_sub(1, std::memory_order_relaxed);
+    }
 
     std::mutex guard;
     std::function<void()> entry_point;
@@ -68,11 +165,11 @@ void Fiber::RewindStartFunc(boost::context::detail::transfer_t transfer) {
 
 Fiber::Fiber(std::function<void()>&& entry_point_func) : impl{std::make_unique<FiberImpl>()} {
     impl->entry_point = std::move(entry_point_func);
-    impl->stack_limit = impl->stack.data();
-    impl->rewind_stack_limit = impl->rewind_stack.data();
+    // The rewind stack is only acquired once the fiber is rewound for the first time
+    impl->stack_limit = stack_pool.Acquire();
     u8* stack_base = impl->stack_limit + default_stack_size;
     impl->context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), FiberStartFunc);
+        boost::context::detail::make_fcontext(stack_base, default_stack_size, FiberStartFunc);
 }
 
 Fiber::Fiber() : impl{std::make_unique<FiberImpl>()} {}
@@ -101,9 +198,12 @@ void Fiber::Exit() {
 void Fiber::Rewind() {
     ASSERT(impl->rewind_point);
     ASSERT(impl->rewind_context == nullptr);
+    if (impl->rewind_stack_limit == nullptr) {
+        impl->rewind_stack_limit = stack_pool.Acquire();
+    }
     u8* stack_base = impl->rewind_stack_limit + default_stack_size;
     impl->rewind_context =
-        boost::context::detail::make_fcontext(stack_base, impl->stack.size(), RewindStartFunc);
+        boost::context::detail::make_fcontext(stack_base, default_stack_size, RewindStartFunc);
     boost::context::detail::jump_fcontext(impl->rewind_context, this);
 }
 
@@ -125,6 +225,16 @@ void Fiber::YieldTo(std::weak_ptr<Fiber> weak_from, Fiber& to) {
     }
 }
 
+Fiber::Statistics Fiber::GetStatistics() {
+    const std::size_t allocated_stacks = stack_pool.AllocatedStacks();
+    return {
+        .live_fibers = live_fibers.load(std::memory_order_relaxed),
+        .allocated_stacks = allocated_stacks,
+        .pooled_stacks = stack_pool.PooledStacks(),
+        .stack_memory = allocated_stacks * stack_allocation_size,
+    };
+}
+
 std::shared_ptr<Fiber> Fiber::ThreadToFiber() {
     std::shared_ptr<Fiber> fiber = std::shared_ptr<Fiber>{new Fiber()};
     fiber->impl->guard.lock();
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -29,6 +30,13 @@ namespace Common {
  */
 class Fiber {
 public:
+    struct Statistics {
+        std::size_t live_fibers;      ///< Fibers currently alive
+        std::size_t allocated_stacks; ///< Stacks currently mapped, in use or pooled
+        std::size_t pooled_stacks;    ///< Stacks kept around for reuse
+        std::size_t stack_memory;     ///< Bytes of address space held by fiber stacks
+    };
+
     Fiber(std::function<void()>&& entry_point_func);
     ~Fiber();
 
@@ -50,6 +58,8 @@ public:
     /// Only call from main thread's fiber
     void Exit();
 
+    [[nodiscard]] static Statistics GetStatistics();
+
 private:
     Fiber();
 
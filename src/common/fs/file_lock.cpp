@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+
+#include "common/fs/file_lock.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+namespace Common::FS {
+
+FileLock::FileLock(const std::filesystem::path& path, FileLockMode mode) {
+#ifdef _WIN32
+    handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                         FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                         OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == InvalidHandle) {
+        LOG_ERROR(Common_Filesystem, "Failed to open lock file {}", PathToUTF8String(path));
+        return;
+    }
+    OVERLAPPED overlapped{};
+    const DWORD flags = mode == FileLockMode::Exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0;
+    if (!LockFileEx(handle, flags, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+        LOG_ERROR(Common_Filesystem, "Failed to lock file {}", PathToUTF8String(path));
+        CloseHandle(handle);
+        handle = InvalidHandle;
+    }
+#else
+    handle = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (handle == InvalidHandle) {
+        LOG_ERROR(Common_Filesystem, "Failed to open lock file {}: {}", PathToUTF8String(path),
+                  std::strerror(errno));
+        return;
+    }
+    const int operation = mode == FileLockMode::Exclusive ? LOCK_EX : LOCK_SH;
+    int result;
+    do {
+        result = flock(handle, operation);
+    } while (result != 0 && errno == EINTR);
+    if (result != 0) {
+        LOG_ERROR(Common_Filesystem, "Failed to lock file {}: {}", PathToUTF8String(path),
+                  std::strerror(errno));
+        close(handle);
+        handle = InvalidHandle;
+    }
+#endif
+}
+
+FileLock::~FileLock() {
+    Unlock();
+}
+
+FileLock::FileLock(FileLock&& other) noexcept
+    : handle{std::exchange(other.handle, InvalidHandle)} {}
+
+FileLock& FileLock::operator=(FileLock&& other) noexcept {
+    if (this != &other) {
+        Unlock();
+        handle = std::exchange(other.handle, InvalidHandle);
+    }
+    return *this;
+}
+
+void FileLock::Unlock() {
+    if (handle == InvalidHandle) {
+        return;
+    }
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    UnlockFileEx(handle, 0, MAXDWORD, MAXDWORD, &overlapped);
+    CloseHandle(handle);
+#else
+    // Closing the descriptor releases the flock
+    close(handle);
+#endif
+    handle = InvalidHandle;
+}
+
+} // namespace Common::FS
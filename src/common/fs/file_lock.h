@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+
+namespace Common::FS {
+
+enum class FileLockMode {
+    Shared,    // Any number of processes may hold the lock at the same time.
+    Exclusive, // Only a single process may hold the lock.
+};
+
+/**
+ * Advisory inter-process lock on a lock file, held for the lifetime of the object.
+ * The lock file is created when it does not exist yet and is never removed, so processes
+ * coordinating on the same path always lock the same file.
+ * Constructing the lock blocks until it is acquired.
+ */
+class FileLock {
+public:
+    explicit FileLock(const std::filesystem::path& path, FileLockMode mode);
+    ~FileLock();
+
+    FileLock(const FileLock&) = delete;
+    FileLock& operator=(const FileLock&) = delete;
+
+    FileLock(FileLock&& other) noexcept;
+    FileLock& operator=(FileLock&& other) noexcept;
+
+    /// Returns whether the lock was acquired. Locking only fails when the lock file can not be
+    /// opened, callers are expected to continue without the lock in that case.
+    [[nodiscard]] bool IsLocked() const {
+        return handle != InvalidHandle;
+    }
+
+private:
+    void Unlock();
+
+#ifdef _WIN32
+    using NativeHandle = void*;
+    static inline const NativeHandle InvalidHandle = reinterpret_cast<NativeHandle>(-1);
+#else
+    using NativeHandle = int;
+    static constexpr NativeHandle InvalidHandle = -1;
+#endif
+
+    NativeHandle handle = InvalidHandle;
+};
+
+} // namespace Common::FS
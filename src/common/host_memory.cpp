@@ -27,8 +27,11 @@
 
 #endif // ^^^ Linux ^^^
 
+#include <array>
+#include <cstdio>
 #include <mutex>
 #include <random>
+#include <string_view>
 
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -89,7 +92,7 @@ static void GetFuncAddress(Common::DynamicLibrary& dll, const char* name, T& pfn
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool /* use_huge_pages */)
         : backing_size{backing_size_}, virtual_size{virtual_size_}, process{GetCurrentProcess()},
           kernelbase_dll("Kernelbase") {
         if (!kernelbase_dll.IsOpen()) {
@@ -427,8 +430,9 @@ static void* ChooseVirtualBase(size_t virtual_size) {
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
-        : backing_size{backing_size_}, virtual_size{virtual_size_} {
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool use_huge_pages_)
+        : backing_size{backing_size_}, virtual_size{virtual_size_},
+          use_huge_pages{use_huge_pages_} {
         bool good = false;
         SCOPE_EXIT {
             if (!good) {
@@ -476,7 +480,11 @@ public:
             throw std::bad_alloc{};
         }
 #if defined(__linux__)
-        madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
+        if (use_huge_pages) {
+            // Fastmem views are separate mappings, they are advised as they get mapped
+            madvise(backing_base, backing_size, MADV_HUGEPAGE);
+            LogShmemHugePageSupport();
+        }
 #endif
 
         free_manager.SetAddressSpace(virtual_base, virtual_size);
@@ -511,6 +519,8 @@ public:
         void* ret = mmap(virtual_base + virtual_offset, length, flags, MAP_SHARED | MAP_FIXED, fd,
                          host_offset);
         ASSERT_MSG(ret != MAP_FAILED, "mmap failed: {}", strerror(errno));
+
+        AdviseHugePages(virtual_base + virtual_offset, host_offset, length);
     }
 
     void Unmap(size_t virtual_offset, size_t length) {
@@ -568,12 +578,56 @@ public:
 
     const size_t backing_size; ///< Size of the backing memory in bytes
     const size_t virtual_size; ///< Size of the virtual address placeholder in bytes
+    const bool use_huge_pages; ///< Whether mappings are backed by transparent huge pages
 
     u8* backing_base{reinterpret_cast<u8*>(MAP_FAILED)};
     u8* virtual_base{reinterpret_cast<u8*>(MAP_FAILED)};
     u8* virtual_map_base{reinterpret_cast<u8*>(MAP_FAILED)};
 
 private:
+    /// Asks for huge pages on the part of a view that can be covered by them
+    void AdviseHugePages(u8* pointer, size_t host_offset, size_t length) {
+#if defined(__linux__)
+        // A huge page maps a huge page aligned block of the backing file, so the view has to be
+        // congruent with the file modulo the huge page size for any of it to qualify.
+        const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        if (!use_huge_pages || (address - host_offset) % HugePageSize != 0) {
+            return;
+        }
+        const uintptr_t begin = Common::AlignUp(address, HugePageSize);
+        const uintptr_t end = Common::AlignDown(address + length, HugePageSize);
+        if (begin < end) {
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+        }
+#endif
+    }
+
+#if defined(__linux__)
+    void LogShmemHugePageSupport() {
+        // Shared memory only honors MADV_HUGEPAGE when the kernel is configured to
+        std::FILE* const file =
+            std::fopen("/sys/kernel/mm/transparent_hugepage/shmem_enabled", "r");
+        if (!file) {
+            return;
+        }
+        std::array<char, 128> mode{};
+        const bool has_mode = std::fgets(mode.data(), static_cast<int>(mode.size()), file);
+        std::fclose(file);
+        if (!has_mode) {
+            return;
+        }
+        const std::string_view modes{mode.data()};
+        if (modes.find("[advise]") == std::string_view::npos &&
+            modes.find("[always]") == std::string_view::npos &&
+            modes.find("[within_size]") == std::string_view::npos) {
+            LOG_INFO(HW_Memory,
+                     "Huge pages are not enabled for shared memory, guest memory will use 4K "
+                     "pages. Set /sys/kernel/mm/transparent_hugepage/shmem_enabled to advise "
+                     "to enable them");
+        }
+    }
+#endif
+
     /// Release all resources in the object
     void Release() {
         if (virtual_map_base != MAP_FAILED) {
@@ -621,7 +675,7 @@ private:
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */) {
+    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */, bool /* use_huge_pages */) {
         // This is just a place holder.
         // Please implement fastmem in a proper way on your platform.
         throw std::bad_alloc{};
@@ -645,14 +699,15 @@ public:
 
 #endif // ^^^ Generic ^^^
 
-HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
+HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_, bool use_huge_pages)
     : backing_size(backing_size_), virtual_size(virtual_size_) {
     try {
         // Try to allocate a fastmem arena.
         // The implementation will fail with std::bad_alloc on errors.
-        impl =
-            std::make_unique<HostMemory::Impl>(AlignUp(backing_size, PageAlignment),
-                                               AlignUp(virtual_size, PageAlignment) + HugePageSize);
+        impl = std::make_unique<HostMemory::Impl>(AlignUp(backing_size, PageAlignment),
+                                                  AlignUp(virtual_size, PageAlignment) +
+                                                      HugePageSize,
+                                                  use_huge_pages);
         backing_base = impl->backing_base;
         virtual_base = impl->virtual_base;
 
@@ -24,7 +24,11 @@ DECLARE_ENUM_FLAG_OPERATORS(MemoryPermission)
  */
 class HostMemory {
 public:
-    explicit HostMemory(size_t backing_size_, size_t virtual_size_);
+    /**
+     * @param use_huge_pages Whether to back the fastmem arena with transparent huge pages where
+     *                       the mappings allow it, only effective on Linux
+     */
+    explicit HostMemory(size_t backing_size_, size_t virtual_size_, bool use_huge_pages = true);
     ~HostMemory();
 
     /**
@@ -3,15 +3,22 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <array>
+#include <bit>
 #include <mutex>
 
-#include "common/intrusive_list.h"
+#include "common/common_types.h"
 
 namespace Common {
 
 class ScopedRangeLock;
 
+/**
+ * Mutual exclusion between overlapping ranges.
+ * The address space is split into blocks that are hashed onto a fixed table of mutexes, a range
+ * locks the stripes of every block it touches. Ranges that overlap always share a stripe, while
+ * disjoint ranges usually take different ones and do not wait on each other.
+ */
 class RangeMutex {
 public:
     explicit RangeMutex() = default;
@@ -20,30 +27,51 @@ public:
 private:
     friend class ScopedRangeLock;
 
-    void Lock(ScopedRangeLock& l);
-    void Unlock(ScopedRangeLock& l);
-    bool HasIntersectionLocked(ScopedRangeLock& l);
+    static constexpr size_t StripeCount = 64;
+    static constexpr u64 BlockBits = 21; ///< Ranges within the same 2 MiB block share a stripe
 
-private:
-    std::mutex m_mutex;
-    std::condition_variable m_cv;
+    static u64 GetStripeMask(u64 address, u64 size) {
+        const u64 first_block = address >> BlockBits;
+        const u64 last_block = (address + size - 1) >> BlockBits;
+        if (last_block - first_block >= StripeCount - 1) {
+            return ~u64{0};
+        }
+        u64 mask = 0;
+        for (u64 block = first_block; block <= last_block; ++block) {
+            mask |= u64{1} << (block % StripeCount);
+        }
+        return mask;
+    }
 
-    using LockList = Common::IntrusiveListBaseTraits<ScopedRangeLock>::ListType;
-    LockList m_list;
+    void Lock(u64 mask) {
+        // Stripes are always taken in ascending order, this keeps concurrent locks deadlock-free
+        for (u64 bits = mask; bits != 0; bits &= bits - 1) {
+            m_stripes[std::countr_zero(bits)].mutex.lock();
+        }
+    }
+
+    void Unlock(u64 mask) {
+        for (u64 bits = mask; bits != 0; bits &= bits - 1) {
+            m_stripes[std::countr_zero(bits)].mutex.unlock();
+        }
+    }
+
+private:
+    struct alignas(64) Stripe {
+        std::mutex mutex;
+    };
+    std::array<Stripe, StripeCount> m_stripes;
 };
 
-class ScopedRangeLock : public Common::IntrusiveListBaseNode<ScopedRangeLock> {
+class ScopedRangeLock {
 public:
     explicit ScopedRangeLock(RangeMutex& mutex, u64 address, u64 size)
-        : m_mutex(mutex), m_address(address), m_size(size) {
-        if (m_size > 0) {
-            m_mutex.Lock(*this);
-        }
+        : m_mutex(mutex), m_address(address), m_size(size),
+          m_stripe_mask(size > 0 ? RangeMutex::GetStripeMask(address, size) : 0) {
+        m_mutex.Lock(m_stripe_mask);
     }
     ~ScopedRangeLock() {
-        if (m_size > 0) {
-            m_mutex.Unlock(*this);
-        }
+        m_mutex.Unlock(m_stripe_mask);
     }
 
     u64 GetAddress() const {
@@ -58,36 +86,7 @@ private:
     RangeMutex& m_mutex;
     const u64 m_address{};
     const u64 m_size{};
+    const u64 m_stripe_mask{};
 };
 
-inline void RangeMutex::Lock(ScopedRangeLock& l) {
-    std::unique_lock lk{m_mutex};
-    m_cv.wait(lk, [&] { return !HasIntersectionLocked(l); });
-    m_list.push_back(l);
-}
-
-inline void RangeMutex::Unlock(ScopedRangeLock& l) {
-    {
-        std::scoped_lock lk{m_mutex};
-        m_list.erase(m_list.iterator_to(l));
-    }
-    m_cv.notify_all();
-}
-
-inline bool RangeMutex::HasIntersectionLocked(ScopedRangeLock& l) {
-    const auto cur_begin = l.GetAddress();
-    const auto cur_last = l.GetAddress() + l.GetSize() - 1;
-
-    for (const auto& other : m_list) {
-        const auto other_begin = other.GetAddress();
-        const auto other_last = other.GetAddress() + other.GetSize() - 1;
-
-        if (cur_begin <= other_last && other_begin <= cur_last) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 } // namespace Common
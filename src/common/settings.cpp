@@ -41,6 +41,7 @@ SWITCHABLE(AntiAliasing, false);
 SWITCHABLE(AspectRatio, true);
 SWITCHABLE(AstcDecodeMode, true);
 SWITCHABLE(AstcRecompression, true);
+SWITCHABLE(AsyncShaderMode, true);
 SWITCHABLE(AudioMode, true);
 SWITCHABLE(ExtendedDynamicState, true);
 SWITCHABLE(CpuBackend, true);
@@ -201,6 +201,8 @@ struct Values {
                                                              MemoryLayout::Memory_16Gb,
                                                              "memory_layout_mode",
                                                              Category::Core};
+    Setting<bool> shared_cache{linkage, false, "shared_cache", Category::Core};
+    Setting<bool> use_huge_pages{linkage, true, "use_huge_pages", Category::Core};
     SwitchableSetting<bool> use_speed_limit{
         linkage, true, "use_speed_limit", Category::Core, Specialization::Paired, false, true};
     SwitchableSetting<u16, true> speed_limit{linkage,
@@ -455,6 +457,18 @@ struct Values {
                                                   Category::RendererAdvanced};
     SwitchableSetting<bool> use_asynchronous_shaders{linkage, false, "use_asynchronous_shaders",
                                                      Category::RendererAdvanced};
+    SwitchableSetting<AsyncShaderMode, true> async_shader_mode{linkage,
+                                                               AsyncShaderMode::Skip,
+                                                               AsyncShaderMode::Wait,
+                                                               AsyncShaderMode::Skip,
+                                                               "async_shader_mode",
+                                                               Category::RendererAdvanced};
+    SwitchableSetting<u16, true> async_shader_wait_budget{linkage,
+                                                          4,
+                                                          0,
+                                                          100,
+                                                          "async_shader_wait_budget",
+                                                          Category::RendererAdvanced};
     SwitchableSetting<bool> use_fast_gpu_time{
         linkage, true, "use_fast_gpu_time", Category::RendererAdvanced, Specialization::Default,
         true,    true};
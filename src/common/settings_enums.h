@@ -876,6 +876,27 @@ inline u32 EnumMetadata<ExtendedDynamicState>::Index() {
     return 26;
 }
 
+enum class AsyncShaderMode : u32 {
+    Wait = 0,
+    Budgeted = 1,
+    Skip = 2,
+};
+
+template <>
+inline std::vector<std::pair<std::string, AsyncShaderMode>>
+EnumMetadata<AsyncShaderMode>::Canonicalizations() {
+    return {
+        {"Wait", AsyncShaderMode::Wait},
+        {"Budgeted", AsyncShaderMode::Budgeted},
+        {"Skip", AsyncShaderMode::Skip},
+    };
+}
+
+template <>
+inline u32 EnumMetadata<AsyncShaderMode>::Index() {
+    return 27;
+}
+
 template <typename Type>
 inline std::string CanonicalizeEnum(Type id) {
     const auto group = EnumMetadata<Type>::Canonicalizations();
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "common/fiber.h"
+#include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/thread.h"
@@ -16,6 +17,34 @@
 #include "video_core/gpu.h"
 
 namespace Core {
+namespace {
+/// Returns the upper bound in microseconds of the bucket holding the given percentile
+u64 WakeupLatencyPercentile(const Kernel::PhysicalCore::WakeupLatencyStatistics& statistics,
+                            u64 total, u64 percentile) {
+    u64 count{};
+    for (std::size_t bucket = 0; bucket < statistics.histogram.size(); ++bucket) {
+        count += statistics.histogram[bucket];
+        if (count * 100 >= total * percentile) {
+            return u64{1} << bucket;
+        }
+    }
+    return u64{1} << (statistics.histogram.size() - 1);
+}
+
+void LogWakeupLatencies(Kernel::KernelCore& kernel, std::size_t num_cores) {
+    for (std::size_t core = 0; core < num_cores; ++core) {
+        const auto statistics = kernel.PhysicalCore(core).GetWakeupLatencyStatistics();
+        const u64 total = statistics.spin_wakeups + statistics.sleep_wakeups;
+        if (total == 0) {
+            continue;
+        }
+        LOG_INFO(Core, "Core {} idle wakeups: {} spinning, {} parked, p50 < {} us, p99 < {} us",
+                 core, statistics.spin_wakeups, statistics.sleep_wakeups,
+                 WakeupLatencyPercentile(statistics, total, 50),
+                 WakeupLatencyPercentile(statistics, total, 99));
+    }
+}
+} // Anonymous namespace
 
 CpuManager::CpuManager(System& system_) : system{system_} {}
 CpuManager::~CpuManager() = default;
@@ -37,6 +66,9 @@ void CpuManager::Shutdown() {
             core_data[core].host_thread.join();
         }
     }
+    if (is_multicore) {
+        LogWakeupLatencies(system.Kernel(), num_cores);
+    }
 }
 
 void CpuManager::GuestThreadFunction() {
@@ -42,6 +42,9 @@ constexpr char GDB_STUB_REPLY_ERR[] = "E01";
 constexpr char GDB_STUB_REPLY_OK[] = "OK";
 constexpr char GDB_STUB_REPLY_EMPTY[] = "";
 
+// Large enough to move 64 KiB of hex encoded memory in one packet
+constexpr size_t GDB_STUB_PACKET_SIZE = 0x20000;
+
 static u8 CalculateChecksum(std::string_view data) {
     return std::accumulate(data.begin(), data.end(), u8{0},
                            [](u8 lhs, u8 rhs) { return static_cast<u8>(lhs + rhs); });
@@ -74,6 +77,21 @@ static std::string EscapeGDB(std::string_view data) {
     return escaped;
 }
 
+static std::vector<u8> UnescapeBinary(std::string_view data) {
+    std::vector<u8> unescaped;
+    unescaped.reserve(data.size());
+
+    for (size_t i = 0; i < data.size(); i++) {
+        if (data[i] == '}' && i + 1 < data.size()) {
+            unescaped.push_back(static_cast<u8>(data[++i] ^ 0x20));
+        } else {
+            unescaped.push_back(static_cast<u8>(data[i]));
+        }
+    }
+
+    return unescaped;
+}
+
 static std::string EscapeXML(std::string_view data) {
     std::u32string converted = U"[Encoding error]";
     try {
@@ -279,30 +297,31 @@ void GDBStub::ExecuteCommand(std::string_view packet, std::vector<DebuggerAction
         const size_t size{static_cast<size_t>(strtoll(command.data() + sep, nullptr, 16))};
 
         std::vector<u8> mem(size);
-        if (GetMemory().ReadBlock(addr, mem.data(), size)) {
-            // Restore any bytes belonging to replaced instructions.
-            auto it = replaced_instructions.lower_bound(addr);
-            for (; it != replaced_instructions.end() && it->first < addr + size; it++) {
-                // Get the bytes of the instruction we previously replaced.
-                const u32 original_bytes = it->second;
-
-                // Calculate where to start writing to the output buffer.
-                const size_t output_offset = it->first - addr;
-
-                // Calculate how many bytes to write.
-                // The loop condition ensures output_offset < size.
-                const size_t n = std::min<size_t>(size - output_offset, sizeof(u32));
-
-                // Write the bytes to the output buffer.
-                std::memcpy(mem.data() + output_offset, &original_bytes, n);
-            }
-
+        if (ReadMemory(addr, mem)) {
             SendReply(Common::HexToString(mem));
         } else {
             SendReply(GDB_STUB_REPLY_ERR);
         }
         break;
     }
+    case 'x': {
+        // Binary read, saves the hex encoding overhead on large memory dumps
+        const auto sep{std::find(command.begin(), command.end(), ',') - command.begin() + 1};
+        const size_t addr{static_cast<size_t>(strtoll(command.data(), nullptr, 16))};
+        const size_t size{static_cast<size_t>(strtoll(command.data() + sep, nullptr, 16))};
+
+        std::vector<u8> mem(size);
+        if (ReadMemory(addr, mem)) {
+            std::string reply;
+            reply.reserve(size + 1);
+            reply += 'b';
+            reply.append(reinterpret_cast<const char*>(mem.data()), mem.size());
+            SendReply(reply);
+        } else {
+            SendReply(GDB_STUB_REPLY_ERR);
+        }
+        break;
+    }
     case 'M': {
         const auto size_sep{std::find(command.begin(), command.end(), ',') - command.begin() + 1};
         const auto mem_sep{std::find(command.begin(), command.end(), ':') - command.begin() + 1};
@@ -313,8 +332,23 @@ void GDBStub::ExecuteCommand(std::string_view packet, std::vector<DebuggerAction
         const auto mem_substr{std::string_view(command).substr(mem_sep)};
         const auto mem{Common::HexStringToVector(mem_substr, false)};
 
-        if (GetMemory().WriteBlock(addr, mem.data(), size)) {
-            Core::InvalidateInstructionCacheRange(GetProcess(), addr, size);
+        if (mem.size() == size && WriteMemory(addr, mem)) {
+            SendReply(GDB_STUB_REPLY_OK);
+        } else {
+            SendReply(GDB_STUB_REPLY_ERR);
+        }
+        break;
+    }
+    case 'X': {
+        const auto size_sep{std::find(command.begin(), command.end(), ',') - command.begin() + 1};
+        const auto mem_sep{std::find(command.begin(), command.end(), ':') - command.begin() + 1};
+
+        const size_t addr{static_cast<size_t>(strtoll(command.data(), nullptr, 16))};
+        const size_t size{static_cast<size_t>(strtoll(command.data() + size_sep, nullptr, 16))};
+
+        // A zero sized write is how GDB probes for binary write support
+        const auto mem{UnescapeBinary(std::string_view(command).substr(mem_sep))};
+        if (mem.size() == size && (size == 0 || WriteMemory(addr, mem))) {
             SendReply(GDB_STUB_REPLY_OK);
         } else {
             SendReply(GDB_STUB_REPLY_ERR);
@@ -447,7 +481,9 @@ static std::string PaginateBuffer(std::string_view buffer, std::string_view requ
     const auto offset_val{static_cast<u64>(strtoll(request.data(), nullptr, 16))};
     const auto amount_val{static_cast<u64>(strtoll(amount.data(), nullptr, 16))};
 
-    if (offset_val + amount_val > buffer.size()) {
+    if (offset_val >= buffer.size()) {
+        return "l";
+    } else if (offset_val + amount_val > buffer.size()) {
         return fmt::format("l{}", buffer.substr(offset_val));
     } else {
         return fmt::format("m{}", buffer.substr(offset_val, amount_val));
@@ -459,8 +495,10 @@ void GDBStub::HandleQuery(std::string_view command) {
         // no tracepoint support
         SendReply("T0");
     } else if (command.starts_with("Supported")) {
-        SendReply("PacketSize=4000;qXfer:features:read+;qXfer:threads:read+;qXfer:libraries:read+;"
-                  "vContSupported+;QStartNoAckMode+");
+        SendReply(fmt::format("PacketSize={:x};qXfer:features:read+;qXfer:threads:read+;"
+                              "qXfer:libraries:read+;qXfer:memory-map:read+;binary-upload+;"
+                              "vContSupported+;QStartNoAckMode+",
+                              GDB_STUB_PACKET_SIZE));
     } else if (command.starts_with("Xfer:features:read:target.xml:")) {
         const auto target_xml{arch->GetTargetXML()};
         SendReply(PaginateBuffer(target_xml, command.substr(30)));
@@ -468,18 +506,15 @@ void GDBStub::HandleQuery(std::string_view command) {
         const auto main_offset = Core::FindMainModuleEntrypoint(GetProcess());
         SendReply(fmt::format("TextSeg={:x}", GetInteger(main_offset)));
     } else if (command.starts_with("Xfer:libraries:read::")) {
-        auto modules = Core::FindModules(GetProcess());
-
-        std::string buffer;
-        buffer += R"(<?xml version="1.0"?>)";
-        buffer += "<library-list>";
-        for (const auto& [base, name] : modules) {
-            buffer += fmt::format(R"(<library name="{}"><segment address="{:#x}"/></library>)",
-                                  EscapeXML(name), base);
-        }
-        buffer += "</library-list>";
-
-        SendReply(PaginateBuffer(buffer, command.substr(21)));
+        const auto request{command.substr(21)};
+        const auto& buffer{
+            GetXferBuffer("libraries", request, [this] { return BuildLibraryList(); })};
+        SendReply(PaginateBuffer(buffer, request));
+    } else if (command.starts_with("Xfer:memory-map:read::")) {
+        const auto request{command.substr(22)};
+        const auto& buffer{
+            GetXferBuffer("memory-map", request, [this] { return BuildMemoryMap(); })};
+        SendReply(PaginateBuffer(buffer, request));
     } else if (command.starts_with("fThreadInfo")) {
         // beginning of list
         const auto& threads = GetProcess()->GetThreadList();
@@ -492,25 +527,9 @@ void GDBStub::HandleQuery(std::string_view command) {
         // end of list
         SendReply("l");
     } else if (command.starts_with("Xfer:threads:read::")) {
-        std::string buffer;
-        buffer += R"(<?xml version="1.0"?>)";
-        buffer += "<threads>";
-
-        const auto& threads = GetProcess()->GetThreadList();
-        for (const auto& thread : threads) {
-            auto thread_name{Core::GetThreadName(&thread)};
-            if (!thread_name) {
-                thread_name = fmt::format("Thread {:d}", thread.GetThreadId());
-            }
-
-            buffer += fmt::format(R"(<thread id="{:x}" core="{:d}" name="{}">{}</thread>)",
-                                  thread.GetThreadId(), thread.GetActiveCore(),
-                                  EscapeXML(*thread_name), GetThreadState(&thread));
-        }
-
-        buffer += "</threads>";
-
-        SendReply(PaginateBuffer(buffer, command.substr(19)));
+        const auto request{command.substr(19)};
+        const auto& buffer{GetXferBuffer("threads", request, [this] { return BuildThreadList(); })};
+        SendReply(PaginateBuffer(buffer, request));
     } else if (command.starts_with("Attached")) {
         SendReply("0");
     } else if (command.starts_with("StartNoAckMode")) {
@@ -712,6 +731,138 @@ void GDBStub::HandleRcmd(const std::vector<u8>& command) {
     SendReply(Common::HexToString(reply_span, false));
 }
 
+bool GDBStub::ReadMemory(VAddr addr, std::span<u8> mem) {
+    if (!GetMemory().ReadBlock(addr, mem.data(), mem.size())) {
+        return false;
+    }
+
+    // Restore any bytes belonging to replaced instructions.
+    auto it = replaced_instructions.lower_bound(addr);
+    for (; it != replaced_instructions.end() && it->first < addr + mem.size(); it++) {
+        // Get the bytes of the instruction we previously replaced.
+        const u32 original_bytes = it->second;
+
+        // Calculate where to start writing to the output buffer.
+        const size_t output_offset = it->first - addr;
+
+        // Calculate how many bytes to write.
+        // The loop condition ensures output_offset < size.
+        const size_t n = std::min<size_t>(mem.size() - output_offset, sizeof(u32));
+
+        // Write the bytes to the output buffer.
+        std::memcpy(mem.data() + output_offset, &original_bytes, n);
+    }
+
+    return true;
+}
+
+bool GDBStub::WriteMemory(VAddr addr, std::span<const u8> mem) {
+    if (!GetMemory().WriteBlock(addr, mem.data(), mem.size())) {
+        return false;
+    }
+
+    Core::InvalidateInstructionCacheRange(GetProcess(), addr, mem.size());
+    return true;
+}
+
+const std::string& GDBStub::GetXferBuffer(std::string_view object, std::string_view request,
+                                          const std::function<std::string()>& generate) {
+    // Objects are generated when a transfer starts, later chunks are served from the cache
+    const auto offset{static_cast<u64>(strtoll(request.data(), nullptr, 16))};
+    if (offset == 0 || object != xfer_object) {
+        xfer_object = object;
+        xfer_buffer = generate();
+    }
+    return xfer_buffer;
+}
+
+std::string GDBStub::BuildLibraryList() {
+    auto modules = Core::FindModules(GetProcess());
+
+    std::string buffer;
+    buffer += R"(<?xml version="1.0"?>)";
+    buffer += "<library-list>";
+    for (const auto& [base, name] : modules) {
+        buffer += fmt::format(R"(<library name="{}"><segment address="{:#x}"/></library>)",
+                              EscapeXML(name), base);
+    }
+    buffer += "</library-list>";
+
+    return buffer;
+}
+
+std::string GDBStub::BuildThreadList() {
+    std::string buffer;
+    buffer += R"(<?xml version="1.0"?>)";
+    buffer += "<threads>";
+
+    const auto& threads = GetProcess()->GetThreadList();
+    for (const auto& thread : threads) {
+        auto thread_name{Core::GetThreadName(&thread)};
+        if (!thread_name) {
+            thread_name = fmt::format("Thread {:d}", thread.GetThreadId());
+        }
+
+        buffer += fmt::format(R"(<thread id="{:x}" core="{:d}" name="{}">{}</thread>)",
+                              thread.GetThreadId(), thread.GetActiveCore(),
+                              EscapeXML(*thread_name), GetThreadState(&thread));
+    }
+
+    buffer += "</threads>";
+
+    return buffer;
+}
+
+std::string GDBStub::BuildMemoryMap() {
+    auto& page_table = GetProcess()->GetPageTable();
+
+    std::string buffer;
+    buffer += R"(<?xml version="1.0"?>)";
+    buffer += R"(<!DOCTYPE memory-map PUBLIC "+//IDN gnu.org//DTD GDB Memory Map V1.0//EN" )"
+              R"("http://sourceware.org/gdb/gdb-memory-map.dtd">)";
+    buffer += "<memory-map>";
+
+    // Adjacent mappings are merged, the client only needs to know what it may access
+    VAddr region_start = 0;
+    VAddr region_end = 0;
+    const auto add_region = [&] {
+        if (region_end != region_start) {
+            buffer += fmt::format(R"(<memory type="ram" start="{:#x}" length="{:#x}"/>)",
+                                  region_start, region_end - region_start);
+        }
+    };
+
+    VAddr cur_addr = 0;
+    while (true) {
+        Kernel::KMemoryInfo mem_info{};
+        Kernel::Svc::PageInfo page_info{};
+        R_ASSERT(page_table.QueryInfo(std::addressof(mem_info), std::addressof(page_info),
+                                      cur_addr));
+        const auto svc_mem_info = mem_info.GetSvcMemoryInfo();
+
+        if (svc_mem_info.state != Kernel::Svc::MemoryState::Free &&
+            svc_mem_info.state != Kernel::Svc::MemoryState::Inaccessible) {
+            if (svc_mem_info.base_address != region_end) {
+                add_region();
+                region_start = svc_mem_info.base_address;
+            }
+            region_end = svc_mem_info.base_address + svc_mem_info.size;
+        }
+
+        const VAddr next_address = svc_mem_info.base_address + svc_mem_info.size;
+        if (next_address <= cur_addr) {
+            break;
+        }
+
+        cur_addr = next_address;
+    }
+    add_region();
+
+    buffer += "</memory-map>";
+
+    return buffer;
+}
+
 Kernel::KThread* GDBStub::GetThreadByID(u64 thread_id) {
     auto& threads{GetProcess()->GetThreadList()};
     for (auto& thread : threads) {
@@ -762,8 +913,14 @@ std::optional<std::string> GDBStub::DetachCommand() {
 
 void GDBStub::SendReply(std::string_view data) {
     const auto escaped{EscapeGDB(data)};
-    const auto output{fmt::format("{}{}{}{:02x}", GDB_STUB_START, escaped, GDB_STUB_END,
-                                  CalculateChecksum(escaped))};
+
+    // Built in place, replies can carry large binary memory transfers
+    std::string output;
+    output.reserve(escaped.size() + 4);
+    output += GDB_STUB_START;
+    output += escaped;
+    output += GDB_STUB_END;
+    output += fmt::format("{:02x}", CalculateChecksum(escaped));
     LOG_TRACE(Debug_GDBStub, "Writing reply: {}", output);
 
     // C++ string support is complete rubbish
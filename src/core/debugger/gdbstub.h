@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -48,6 +51,15 @@ private:
     std::optional<std::string> DetachCommand();
     Kernel::KThread* GetThreadByID(u64 thread_id);
 
+    bool ReadMemory(VAddr addr, std::span<u8> mem);
+    bool WriteMemory(VAddr addr, std::span<const u8> mem);
+
+    const std::string& GetXferBuffer(std::string_view object, std::string_view request,
+                                     const std::function<std::string()>& generate);
+    std::string BuildLibraryList();
+    std::string BuildThreadList();
+    std::string BuildMemoryMap();
+
     void SendReply(std::string_view data);
     void SendStatus(char status);
 
@@ -60,6 +72,8 @@ private:
     std::unique_ptr<GDBStubArch> arch;
     std::vector<char> current_command;
     std::map<VAddr, u32> replaced_instructions;
+    std::string xfer_object;
+    std::string xfer_buffer;
     bool no_ack{};
 };
 
@@ -250,9 +250,11 @@ void GDBStubA64::WriteRegisters(Kernel::KThread* thread, std::string_view regist
 }
 
 std::string GDBStubA64::ThreadStatus(const Kernel::KThread* thread, u8 signal) const {
-    return fmt::format("T{:02x}{:02x}:{};{:02x}:{};{:02x}:{};thread:{:x};", signal, PC_REGISTER,
-                       RegRead(thread, PC_REGISTER), SP_REGISTER, RegRead(thread, SP_REGISTER),
-                       LR_REGISTER, RegRead(thread, LR_REGISTER), thread->GetThreadId());
+    // FP is expedited as well, so that the client can unwind the stack without a register read
+    return fmt::format("T{:02x}{:02x}:{};{:02x}:{};{:02x}:{};{:02x}:{};thread:{:x};", signal,
+                       PC_REGISTER, RegRead(thread, PC_REGISTER), SP_REGISTER,
+                       RegRead(thread, SP_REGISTER), LR_REGISTER, RegRead(thread, LR_REGISTER),
+                       FP_REGISTER, RegRead(thread, FP_REGISTER), thread->GetThreadId());
 }
 
 u32 GDBStubA64::BreakpointInstruction() const {
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
+
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree.h"
 #include "core/file_sys/fssystem/fssystem_bucket_tree_utils.h"
@@ -16,6 +19,20 @@ static_assert(std::is_trivial_v<Node>);
 
 constexpr inline s32 NodeHeaderSize = sizeof(BucketTree::NodeHeader);
 
+std::atomic<u64> g_next_table_cache_id{1};
+
+// The entry set the last lookup of a cached tree landed in, sequential reads of a storage mostly
+// stay within it and can skip the search from the root
+struct LastEntrySet {
+    u64 table_cache_id;
+    s32 index;
+};
+thread_local std::array<LastEntrySet, 4> g_last_entry_sets{};
+
+LastEntrySet& GetLastEntrySet(u64 table_cache_id) {
+    return g_last_entry_sets[table_cache_id % g_last_entry_sets.size()];
+}
+
 class StorageNode {
 private:
     class Offset {
@@ -226,6 +243,9 @@ Result BucketTree::Initialize(VirtualFile node_storage, VirtualFile entry_storag
     m_offset_cache.offsets.end_offset = end_offset;
     m_offset_cache.is_initialized = true;
 
+    // Keep the tables in memory if we can.
+    this->CacheTables();
+
     // We succeeded.
     R_SUCCEED();
 }
@@ -257,9 +277,43 @@ void BucketTree::Finalize() {
         m_offset_cache.offsets.start_offset = 0;
         m_offset_cache.offsets.end_offset = 0;
         m_offset_cache.is_initialized = false;
+
+        m_node_cache = {};
+        m_entry_cache = {};
+        m_table_cache_id = 0;
     }
 }
 
+void BucketTree::CacheTables() {
+    // The tables of patch NCAs sit behind decrypting storages, every uncached lookup would read
+    // and decrypt the same nodes again.
+    const size_t node_storage_size = m_node_storage->GetSize();
+    const size_t entry_storage_size = m_entry_storage->GetSize();
+    if (node_storage_size + entry_storage_size > TableCacheSizeMax) {
+        return;
+    }
+
+    m_node_cache.resize(node_storage_size);
+    m_entry_cache.resize(entry_storage_size);
+    if (m_node_storage->Read(reinterpret_cast<u8*>(m_node_cache.data()), node_storage_size) !=
+            node_storage_size ||
+        m_entry_storage->Read(reinterpret_cast<u8*>(m_entry_cache.data()), entry_storage_size) !=
+            entry_storage_size) {
+        m_node_cache = {};
+        m_entry_cache = {};
+        return;
+    }
+    m_table_cache_id = g_next_table_cache_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BucketTree::ReadEntryStorage(void* buffer, size_t size, s64 offset) const {
+    if (const char* const cached = GetCachedRange(m_entry_cache, offset, size)) {
+        std::memcpy(buffer, cached, size);
+        return;
+    }
+    m_entry_storage->Read(reinterpret_cast<u8*>(buffer), size, offset);
+}
+
 Result BucketTree::Find(Visitor* visitor, s64 virtual_address) {
     ASSERT(visitor != nullptr);
     ASSERT(this->IsInitialized());
@@ -349,7 +403,7 @@ Result BucketTree::Visitor::MoveNext() {
         const auto entry_set_size = m_tree->m_node_size;
         const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-        m_tree->m_entry_storage->ReadObject(std::addressof(m_entry_set), entry_set_offset);
+        m_tree->ReadEntryStorageObject(std::addressof(m_entry_set), entry_set_offset);
         R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
         R_UNLESS(m_entry_set.info.start == end && m_entry_set.info.start < m_entry_set.info.end,
@@ -364,7 +418,7 @@ Result BucketTree::Visitor::MoveNext() {
     const auto entry_size = m_tree->m_entry_size;
     const auto entry_offset = impl::GetBucketTreeEntryOffset(
         m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-    m_tree->m_entry_storage->Read(reinterpret_cast<u8*>(m_entry), entry_size, entry_offset);
+    m_tree->ReadEntryStorage(m_entry, entry_size, entry_offset);
 
     // Note that we changed index.
     m_entry_index = entry_index;
@@ -387,7 +441,7 @@ Result BucketTree::Visitor::MovePrevious() {
         const auto entry_set_index = m_entry_set.info.index - 1;
         const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
 
-        m_tree->m_entry_storage->ReadObject(std::addressof(m_entry_set), entry_set_offset);
+        m_tree->ReadEntryStorageObject(std::addressof(m_entry_set), entry_set_offset);
         R_TRY(m_entry_set.header.Verify(entry_set_index, entry_set_size, m_tree->m_entry_size));
 
         R_UNLESS(m_entry_set.info.end == start && m_entry_set.info.start < m_entry_set.info.end,
@@ -404,7 +458,7 @@ Result BucketTree::Visitor::MovePrevious() {
     const auto entry_size = m_tree->m_entry_size;
     const auto entry_offset = impl::GetBucketTreeEntryOffset(
         m_entry_set.info.index, m_tree->m_node_size, entry_size, entry_index);
-    m_tree->m_entry_storage->Read(reinterpret_cast<u8*>(m_entry), entry_size, entry_offset);
+    m_tree->ReadEntryStorage(m_entry, entry_size, entry_offset);
 
     // Note that we changed index.
     m_entry_index = entry_index;
@@ -418,6 +472,24 @@ Result BucketTree::Visitor::Find(s64 virtual_address) {
     const auto* const node = m_tree->m_node_l1.Get<Node>();
     R_UNLESS(virtual_address < node->GetEndOffset(), ResultOutOfRange);
 
+    // Try the entry set of the previous lookup on this thread first.
+    const auto table_cache_id = m_tree->m_table_cache_id;
+    if (table_cache_id != 0) {
+        auto& last_entry_set = GetLastEntrySet(table_cache_id);
+        const char* const entry_set = last_entry_set.table_cache_id == table_cache_id
+                                          ? m_tree->GetCachedEntrySet(last_entry_set.index)
+                                          : nullptr;
+        if (entry_set != nullptr) {
+            EntrySetHeader header;
+            std::memcpy(std::addressof(header), entry_set, sizeof(EntrySetHeader));
+            if (header.info.start <= virtual_address && virtual_address < header.info.end) {
+                R_TRY(this->FindEntryInBuffer(virtual_address, last_entry_set.index, entry_set));
+                m_entry_set_count = m_tree->m_entry_set_count;
+                R_SUCCEED();
+            }
+        }
+    }
+
     // Get the entry set index.
     s32 entry_set_index = -1;
     if (m_tree->IsExistOffsetL2OnL1() && virtual_address < node->GetBeginOffset()) {
@@ -455,6 +527,11 @@ Result BucketTree::Visitor::Find(s64 virtual_address) {
     // Find the entry.
     R_TRY(this->FindEntry(virtual_address, entry_set_index));
 
+    // Remember the entry set for the next lookup.
+    if (table_cache_id != 0) {
+        GetLastEntrySet(table_cache_id) = {table_cache_id, entry_set_index};
+    }
+
     // Set count.
     m_entry_set_count = m_tree->m_entry_set_count;
     R_SUCCEED();
@@ -463,6 +540,12 @@ Result BucketTree::Visitor::Find(s64 virtual_address) {
 Result BucketTree::Visitor::FindEntrySet(s32* out_index, s64 virtual_address, s32 node_index) {
     const auto node_size = m_tree->m_node_size;
 
+    // Search the node in place if it is held in memory.
+    const auto node_offset = (node_index + 1) * static_cast<s64>(node_size);
+    if (const char* const node = m_tree->GetCachedNode(node_offset)) {
+        R_RETURN(this->FindEntrySetInBuffer(out_index, virtual_address, node_index, node));
+    }
+
     PooledBuffer pool(node_size, 1);
     if (node_size <= pool.GetSize()) {
         R_RETURN(
@@ -483,6 +566,13 @@ Result BucketTree::Visitor::FindEntrySetWithBuffer(s32* out_index, s64 virtual_a
     // Read the node.
     storage->Read(reinterpret_cast<u8*>(buffer), node_size, node_offset);
 
+    R_RETURN(this->FindEntrySetInBuffer(out_index, virtual_address, node_index, buffer));
+}
+
+Result BucketTree::Visitor::FindEntrySetInBuffer(s32* out_index, s64 virtual_address,
+                                                 s32 node_index, const char* buffer) {
+    const auto node_size = m_tree->m_node_size;
+
     // Validate the header.
     NodeHeader header;
     std::memcpy(std::addressof(header), buffer, NodeHeaderSize);
@@ -523,6 +613,11 @@ Result BucketTree::Visitor::FindEntrySetWithoutBuffer(s32* out_index, s64 virtua
 Result BucketTree::Visitor::FindEntry(s64 virtual_address, s32 entry_set_index) {
     const auto entry_set_size = m_tree->m_node_size;
 
+    // Search the entry set in place if it is held in memory.
+    if (const char* const entry_set = m_tree->GetCachedEntrySet(entry_set_index)) {
+        R_RETURN(this->FindEntryInBuffer(virtual_address, entry_set_index, entry_set));
+    }
+
     PooledBuffer pool(entry_set_size, 1);
     if (entry_set_size <= pool.GetSize()) {
         R_RETURN(this->FindEntryWithBuffer(virtual_address, entry_set_index, pool.GetBuffer()));
@@ -535,7 +630,6 @@ Result BucketTree::Visitor::FindEntry(s64 virtual_address, s32 entry_set_index)
 Result BucketTree::Visitor::FindEntryWithBuffer(s64 virtual_address, s32 entry_set_index,
                                                 char* buffer) {
     // Calculate entry set extents.
-    const auto entry_size = m_tree->m_entry_size;
     const auto entry_set_size = m_tree->m_node_size;
     const auto entry_set_offset = entry_set_index * static_cast<s64>(entry_set_size);
     VirtualFile storage = m_tree->m_entry_storage;
@@ -543,6 +637,15 @@ Result BucketTree::Visitor::FindEntryWithBuffer(s64 virtual_address, s32 entry_s
     // Read the entry set.
     storage->Read(reinterpret_cast<u8*>(buffer), entry_set_size, entry_set_offset);
 
+    R_RETURN(this->FindEntryInBuffer(virtual_address, entry_set_index, buffer));
+}
+
+Result BucketTree::Visitor::FindEntryInBuffer(s64 virtual_address, s32 entry_set_index,
+                                              const char* buffer) {
+    // Calculate entry set extents.
+    const auto entry_size = m_tree->m_entry_size;
+    const auto entry_set_size = m_tree->m_node_size;
+
     // Validate the entry_set.
     EntrySetHeader entry_set;
     std::memcpy(std::addressof(entry_set), buffer, sizeof(EntrySetHeader));
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <mutex>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/common_funcs.h"
@@ -28,6 +29,9 @@ public:
     static constexpr size_t NodeSizeMin = 1_KiB;
     static constexpr size_t NodeSizeMax = 512_KiB;
 
+    // Tables up to this size are kept in memory instead of being read back on every lookup
+    static constexpr size_t TableCacheSizeMax = 32_MiB;
+
 public:
     class Visitor;
 
@@ -221,7 +225,8 @@ private:
 public:
     BucketTree()
         : m_node_storage(), m_entry_storage(), m_node_l1(), m_node_size(), m_entry_size(),
-          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache() {}
+          m_entry_count(), m_offset_count(), m_entry_set_count(), m_offset_cache(),
+          m_node_cache(), m_entry_cache(), m_table_cache_id() {}
     ~BucketTree() {
         this->Finalize();
     }
@@ -317,6 +322,33 @@ private:
 
     Result EnsureOffsetCache();
 
+    void CacheTables();
+
+    static const char* GetCachedRange(const std::vector<char>& cache, s64 offset, size_t size) {
+        if (offset < 0 || static_cast<size_t>(offset) > cache.size() ||
+            size > cache.size() - static_cast<size_t>(offset)) {
+            return nullptr;
+        }
+        return cache.data() + offset;
+    }
+
+    const char* GetCachedNode(s64 node_offset) const {
+        return GetCachedRange(m_node_cache, node_offset, m_node_size);
+    }
+
+    const char* GetCachedEntrySet(s32 entry_set_index) const {
+        return GetCachedRange(m_entry_cache, entry_set_index * static_cast<s64>(m_node_size),
+                              m_node_size);
+    }
+
+    void ReadEntryStorage(void* buffer, size_t size, s64 offset) const;
+
+    template <typename T>
+    void ReadEntryStorageObject(T* object, s64 offset) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+        this->ReadEntryStorage(object, sizeof(T), offset);
+    }
+
 private:
     mutable VirtualFile m_node_storage;
     mutable VirtualFile m_entry_storage;
@@ -327,6 +359,9 @@ private:
     s32 m_offset_count;
     s32 m_entry_set_count;
     OffsetCache m_offset_cache;
+    std::vector<char> m_node_cache;
+    std::vector<char> m_entry_cache;
+    u64 m_table_cache_id; //!< Identifies the in-memory tables, zero if they are not cached
 };
 
 class BucketTree::Visitor {
@@ -385,10 +420,13 @@ private:
     Result FindEntrySetWithBuffer(s32* out_index, s64 virtual_address, s32 node_index,
                                   char* buffer);
     Result FindEntrySetWithoutBuffer(s32* out_index, s64 virtual_address, s32 node_index);
+    Result FindEntrySetInBuffer(s32* out_index, s64 virtual_address, s32 node_index,
+                                const char* buffer);
 
     Result FindEntry(s64 virtual_address, s32 entry_set_index);
     Result FindEntryWithBuffer(s64 virtual_address, s32 entry_set_index, char* buffer);
     Result FindEntryWithoutBuffer(s64 virtual_address, s32 entry_set_index);
+    Result FindEntryInBuffer(s64 virtual_address, s32 entry_set_index, const char* buffer);
 
 private:
     friend class BucketTree;
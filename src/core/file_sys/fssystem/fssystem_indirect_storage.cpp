@@ -106,13 +106,38 @@ size_t IndirectStorage::Read(u8* buffer, size_t size, size_t offset) const {
         return 0;
     }
 
+    // Pieces that continue the previous one in the same storage are merged into a single read.
+    // Pieces are still issued in order, fragments overwrite the continuous read beneath them.
+    struct PendingRead {
+        VirtualFile storage;
+        s64 data_offset;
+        s64 offset;
+        s64 size;
+    } pending{};
+
+    const auto flush = [&] {
+        if (pending.size > 0) {
+            pending.storage->Read(buffer + (pending.offset - offset),
+                                  static_cast<size_t>(pending.size), pending.data_offset);
+        }
+        pending = {};
+    };
+
     const_cast<IndirectStorage*>(this)->OperatePerEntry<true, true>(
         offset, size,
-        [=](VirtualFile storage, s64 data_offset, s64 cur_offset, s64 cur_size) -> Result {
-            storage->Read(reinterpret_cast<u8*>(buffer) + (cur_offset - offset),
-                          static_cast<size_t>(cur_size), data_offset);
+        [&](VirtualFile storage, s64 data_offset, s64 cur_offset, s64 cur_size) -> Result {
+            if (pending.size > 0 && pending.storage == storage &&
+                pending.data_offset + pending.size == data_offset &&
+                pending.offset + pending.size == cur_offset) {
+                pending.size += cur_size;
+                R_SUCCEED();
+            }
+
+            flush();
+            pending = {std::move(storage), data_offset, cur_offset, cur_size};
             R_SUCCEED();
         });
+    flush();
 
     return size;
 }
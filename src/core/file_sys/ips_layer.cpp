@@ -4,11 +4,15 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
+#include "common/cityhash.h"
 #include "common/hex_util.h"
+#include "common/literals.h"
 #include "common/logging/log.h"
 #include "common/swap.h"
 #include "core/file_sys/ips_layer.h"
@@ -16,6 +20,8 @@
 
 namespace FileSys {
 
+using namespace Common::Literals;
+
 enum class IPSFileType {
     IPS,
     IPS32,
@@ -64,19 +70,30 @@ static bool IsEOF(IPSFileType type, const std::vector<u8>& data) {
     return type == IPSFileType::IPS32 && std::equal(data.begin(), data.end(), eeof.begin());
 }
 
-VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
-    if (in == nullptr || ips == nullptr)
-        return nullptr;
+bool CompiledPatch::IsApplicable(std::size_t image_size) const {
+    if (image_size == 0) {
+        return false;
+    }
+    if (!is_strict) {
+        return true;
+    }
+    return std::ranges::all_of(records, [image_size](const Record& record) {
+        if (record.offset > image_size) {
+            return false;
+        }
+        return record.is_rle || record.offset + record.size <= image_size;
+    });
+}
+
+std::optional<CompiledPatch> CompileIPS(const VirtualFile& ips) {
+    if (ips == nullptr)
+        return std::nullopt;
 
     const auto type = IdentifyMagic(ips->ReadBytes(0x5));
     if (type == IPSFileType::Error)
-        return nullptr;
-
-    auto in_data = in->ReadAllBytes();
-    if (in_data.size() == 0) {
-        return nullptr;
-    }
+        return std::nullopt;
 
+    CompiledPatch patch{.is_strict = true};
     std::vector<u8> temp(type == IPSFileType::IPS ? 3 : 4);
     u64 offset = 5; // After header
     while (ips->Read(temp.data(), temp.size(), offset) == temp.size()) {
@@ -91,44 +108,178 @@ VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
         else
             real_offset = (temp[0] << 16) | (temp[1] << 8) | temp[2];
 
-        if (real_offset > in_data.size()) {
-            return nullptr;
-        }
-
         u16 data_size{};
         if (ips->ReadObject(&data_size, offset) != sizeof(u16))
-            return nullptr;
+            return std::nullopt;
         data_size = Common::swap16(data_size);
         offset += sizeof(u16);
 
         if (data_size == 0) { // RLE
             u16 rle_size{};
             if (ips->ReadObject(&rle_size, offset) != sizeof(u16))
-                return nullptr;
+                return std::nullopt;
             rle_size = Common::swap16(rle_size);
             offset += sizeof(u16);
 
             const auto data = ips->ReadByte(offset++);
             if (!data)
-                return nullptr;
+                return std::nullopt;
 
-            if (real_offset + rle_size > in_data.size())
-                rle_size = static_cast<u16>(in_data.size() - real_offset);
-            std::memset(in_data.data() + real_offset, *data, rle_size);
+            patch.records.push_back({real_offset, rle_size, {*data}, true});
         } else { // Standard Patch
-            auto read = data_size;
-            if (real_offset + read > in_data.size())
-                read = static_cast<u16>(in_data.size() - real_offset);
-            if (ips->Read(in_data.data() + real_offset, read, offset) != data_size)
-                return nullptr;
+            std::vector<u8> data(data_size);
+            if (ips->Read(data.data(), data_size, offset) != data_size)
+                return std::nullopt;
             offset += data_size;
+
+            patch.records.push_back({real_offset, data_size, std::move(data), false});
         }
     }
 
     if (!IsEOF(type, temp)) {
+        return std::nullopt;
+    }
+
+    return patch;
+}
+
+std::shared_ptr<const CompiledPatch> GetCompiledPatch(const VirtualFile& patch_file) {
+    if (patch_file == nullptr)
+        return nullptr;
+
+    const auto extension = patch_file->GetExtension();
+    const bool is_text = extension == "pchtxt";
+    if (!is_text && extension != "ips")
+        return nullptr;
+
+    // Bounds the cache over a session that boots many titles, it is dropped as a whole once full
+    static constexpr std::size_t MaxCachedPatches = 256;
+    static constexpr std::size_t MaxCachedBytes = 32_MiB;
+
+    static std::mutex cache_mutex;
+    static std::unordered_map<u64, std::shared_ptr<const CompiledPatch>> cache;
+    static std::size_t cached_bytes = 0;
+
+    auto bytes = patch_file->ReadAllBytes();
+    const u64 hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(bytes.data()),
+                                                bytes.size(), is_text ? 1 : 0);
+    {
+        std::scoped_lock lock{cache_mutex};
+        if (const auto it = cache.find(hash); it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    const auto file = std::make_shared<VectorVfsFile>(std::move(bytes), patch_file->GetName());
+    std::shared_ptr<const CompiledPatch> compiled;
+    if (is_text) {
+        const IPSwitchCompiler compiler{file};
+        if (compiler.IsValid()) {
+            compiled = std::make_shared<const CompiledPatch>(compiler.Compile());
+        }
+    } else if (auto patch = CompileIPS(file)) {
+        compiled = std::make_shared<const CompiledPatch>(std::move(*patch));
+    }
+
+    std::size_t compiled_bytes = 0;
+    if (compiled != nullptr) {
+        for (const auto& record : compiled->records) {
+            compiled_bytes += record.data.size();
+        }
+    }
+
+    // Invalid files are cached as well, so they are not parsed again
+    std::scoped_lock lock{cache_mutex};
+    if (const auto it = cache.find(hash); it != cache.end()) {
+        return it->second;
+    }
+    if (cache.size() >= MaxCachedPatches || cached_bytes + compiled_bytes > MaxCachedBytes) {
+        cache.clear();
+        cached_bytes = 0;
+    }
+    cached_bytes += compiled_bytes;
+    return cache.emplace(hash, std::move(compiled)).first->second;
+}
+
+void ApplyPatches(std::vector<u8>& image, std::span<const CompiledPatch* const> patches) {
+    struct Fragment {
+        u64 offset;
+        u64 size;
+        const u8* data;
+        bool is_rle;
+    };
+    std::vector<Fragment> fragments;
+
+    // Records are visited from highest to lowest priority, each one only contributes the bytes
+    // that no later record has claimed yet. Covered ranges are kept disjoint as [begin, end).
+    std::map<u64, u64> covered;
+    const auto paint = [&](const CompiledPatch::Record& record, u64 begin, u64 end) {
+        auto it = covered.upper_bound(begin);
+        if (it != covered.begin() && std::prev(it)->second >= begin) {
+            --it;
+        }
+        u64 cursor = begin;
+        u64 merged_begin = begin;
+        u64 merged_end = end;
+        while (it != covered.end() && it->first <= end) {
+            if (it->first > cursor) {
+                fragments.push_back({cursor, it->first - cursor,
+                                     record.data.data() + (record.is_rle ? 0 : cursor - begin),
+                                     record.is_rle});
+            }
+            cursor = std::max(cursor, it->second);
+            merged_begin = std::min(merged_begin, it->first);
+            merged_end = std::max(merged_end, it->second);
+            it = covered.erase(it);
+        }
+        if (cursor < end) {
+            fragments.push_back({cursor, end - cursor,
+                                 record.data.data() + (record.is_rle ? 0 : cursor - begin),
+                                 record.is_rle});
+        }
+        covered.emplace(merged_begin, merged_end);
+    };
+
+    for (auto patch_it = patches.rbegin(); patch_it != patches.rend(); ++patch_it) {
+        const CompiledPatch& patch = **patch_it;
+        if (!patch.IsApplicable(image.size()))
+            continue;
+
+        for (auto it = patch.records.rbegin(); it != patch.records.rend(); ++it) {
+            if (it->offset >= image.size() || it->size == 0)
+                continue;
+            const u64 end = std::min<u64>(u64{it->offset} + it->size, image.size());
+            paint(*it, it->offset, end);
+        }
+    }
+
+    // Fragments do not overlap, write them front to back
+    std::ranges::sort(fragments, {}, &Fragment::offset);
+    for (const Fragment& fragment : fragments) {
+        if (fragment.is_rle) {
+            std::memset(image.data() + fragment.offset, *fragment.data, fragment.size);
+        } else {
+            std::memcpy(image.data() + fragment.offset, fragment.data, fragment.size);
+        }
+    }
+}
+
+VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips) {
+    if (in == nullptr || ips == nullptr)
+        return nullptr;
+
+    const auto patch = CompileIPS(ips);
+    if (!patch)
+        return nullptr;
+
+    auto in_data = in->ReadAllBytes();
+    if (!patch->IsApplicable(in_data.size())) {
         return nullptr;
     }
 
+    const std::array<const CompiledPatch*, 1> patches{&*patch};
+    ApplyPatches(in_data, patches);
+
     return std::make_shared<VectorVfsFile>(std::move(in_data), in->GetName(),
                                            in->GetContainingDirectory());
 }
@@ -316,26 +467,28 @@ void IPSwitchCompiler::Parse() {
     valid = true;
 }
 
-VirtualFile IPSwitchCompiler::Apply(const VirtualFile& in) const {
-    if (in == nullptr || !valid)
-        return nullptr;
-
-    auto in_data = in->ReadAllBytes();
-
+CompiledPatch IPSwitchCompiler::Compile() const {
+    CompiledPatch compiled{.build_id = nso_build_id};
     for (const auto& patch : patches) {
         if (!patch.enabled)
             continue;
 
-        for (const auto& record : patch.records) {
-            if (record.first >= in_data.size())
-                continue;
-            auto replace_size = record.second.size();
-            if (record.first + replace_size > in_data.size())
-                replace_size = in_data.size() - record.first;
-            for (std::size_t i = 0; i < replace_size; ++i)
-                in_data[i + record.first] = record.second[i];
+        for (const auto& [offset, replace] : patch.records) {
+            compiled.records.push_back(
+                {offset, static_cast<u32>(replace.size()), replace, false});
         }
     }
+    return compiled;
+}
+
+VirtualFile IPSwitchCompiler::Apply(const VirtualFile& in) const {
+    if (in == nullptr || !valid)
+        return nullptr;
+
+    auto in_data = in->ReadAllBytes();
+    const auto compiled = Compile();
+    const std::array<const CompiledPatch*, 1> compiled_patches{&compiled};
+    ApplyPatches(in_data, compiled_patches);
 
     return std::make_shared<VectorVfsFile>(std::move(in_data), in->GetName(),
                                            in->GetContainingDirectory());
@@ -5,6 +5,8 @@
 
 #include <array>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -12,6 +14,34 @@
 
 namespace FileSys {
 
+/// Byte replacements parsed from an IPS or IPSwitch patch file.
+struct CompiledPatch {
+    struct Record {
+        u32 offset;
+        u32 size;
+        std::vector<u8> data; ///< Replacement bytes, or the single fill byte of an RLE record
+        bool is_rle;
+    };
+
+    /// Whether the patch can be applied to an image of the given size. IPS patches are rejected
+    /// as a whole if a record lies outside of the image, IPSwitch records are clipped instead.
+    bool IsApplicable(std::size_t image_size) const;
+
+    std::vector<Record> records;
+    std::array<u8, 0x20> build_id{}; ///< Target NSO of an IPSwitch patch
+    bool is_strict = false;
+};
+
+std::optional<CompiledPatch> CompileIPS(const VirtualFile& ips);
+
+/// Returns the compiled form of an .ips or .pchtxt file, or nullptr if it is invalid. Patches
+/// are cached by content hash, so a file is only parsed once while it stays in the bounded cache.
+std::shared_ptr<const CompiledPatch> GetCompiledPatch(const VirtualFile& patch_file);
+
+/// Applies the patches to the image in order, later patches taking priority over earlier ones.
+/// Overlapping records are resolved up front so every byte is written at most once.
+void ApplyPatches(std::vector<u8>& image, std::span<const CompiledPatch* const> patches);
+
 VirtualFile PatchIPS(const VirtualFile& in, const VirtualFile& ips);
 
 class IPSwitchCompiler {
@@ -21,6 +51,7 @@ public:
 
     std::array<u8, 0x20> GetBuildID() const;
     bool IsValid() const;
+    CompiledPatch Compile() const;
     VirtualFile Apply(const VirtualFile& in) const;
 
 private:
@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <cstring>
+#include <future>
+#include <vector>
 
 #include "common/string_util.h"
 #include "core/file_sys/kernel_executable.h"
@@ -97,23 +99,38 @@ KIP::KIP(const VirtualFile& file) : status(Loader::ResultStatus::Success) {
         return;
     }
 
+    // Read all sections first, files don't support concurrent reads
     u64 offset = sizeof(KIPHeader);
+    std::vector<std::size_t> compressed_sections;
     for (std::size_t i = 0; i < header.sections.size(); ++i) {
         auto compressed = file->ReadBytes(header.sections[i].compressed_size, offset);
         offset += header.sections[i].compressed_size;
 
         if (header.sections[i].compressed_size == 0 && header.sections[i].decompressed_size != 0) {
             decompressed_sections[i] = std::vector<u8>(header.sections[i].decompressed_size);
-        } else if (header.sections[i].compressed_size == header.sections[i].decompressed_size) {
-            decompressed_sections[i] = std::move(compressed);
         } else {
-            decompressed_sections[i] = compressed;
-            if (!DecompressBLZ(decompressed_sections[i])) {
-                status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
-                return;
+            decompressed_sections[i] = std::move(compressed);
+            if (header.sections[i].compressed_size != header.sections[i].decompressed_size) {
+                compressed_sections.push_back(i);
             }
         }
     }
+
+    // BLZ decompression is sequential, but sections are independent of each other
+    std::vector<std::future<bool>> pending_sections;
+    for (std::size_t j = 0; j + 1 < compressed_sections.size(); ++j) {
+        auto& section = decompressed_sections[compressed_sections[j]];
+        pending_sections.push_back(
+            std::async(std::launch::async, [&section] { return DecompressBLZ(section); }));
+    }
+    bool is_decompressed = compressed_sections.empty() ||
+                           DecompressBLZ(decompressed_sections[compressed_sections.back()]);
+    for (auto& pending_section : pending_sections) {
+        is_decompressed &= pending_section.get();
+    }
+    if (!is_decompressed) {
+        status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
+    }
 }
 
 Loader::ResultStatus KIP::GetStatus() const {
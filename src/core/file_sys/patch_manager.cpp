@@ -25,7 +25,6 @@
 #include "core/file_sys/romfs.h"
 #include "core/file_sys/vfs/vfs_cached.h"
 #include "core/file_sys/vfs/vfs_layered.h"
-#include "core/file_sys/vfs/vfs_vector.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/hle/service/ns/language.h"
 #include "core/hle/service/set/settings_server.h"
@@ -235,10 +234,10 @@ std::vector<VirtualFile> PatchManager::CollectPatches(const std::vector<VirtualD
                     if (nso_build_id == this_build_id)
                         out.push_back(file);
                 } else if (file->GetExtension() == "pchtxt") {
-                    IPSwitchCompiler compiler{file};
-                    if (!compiler.IsValid())
+                    const auto compiled = GetCompiledPatch(file);
+                    if (compiled == nullptr)
                         continue;
-                    const auto this_build_id = Common::HexToString(compiler.GetBuildID());
+                    const auto this_build_id = Common::HexToString(compiled->build_id);
                     if (nso_build_id == this_build_id)
                         out.push_back(file);
                 }
@@ -280,23 +279,25 @@ std::vector<u8> PatchManager::PatchNSO(const std::vector<u8>& nso, const std::st
     std::sort(patch_dirs.begin(), patch_dirs.end(),
               [](const VirtualDir& l, const VirtualDir& r) { return l->GetName() < r->GetName(); });
     const auto patches = CollectPatches(patch_dirs, build_id);
-    auto out = nso;
+    std::vector<std::shared_ptr<const CompiledPatch>> compiled_patches;
+    compiled_patches.reserve(patches.size());
     for (const auto& patch_file : patches) {
-        if (patch_file->GetExtension() == "ips") {
-            LOG_INFO(Loader, "    - Applying IPS patch from mod \"{}\"",
-                     patch_file->GetContainingDirectory()->GetParentDirectory()->GetName());
-            const auto patched = PatchIPS(std::make_shared<VectorVfsFile>(out), patch_file);
-            if (patched != nullptr)
-                out = patched->ReadAllBytes();
-        } else if (patch_file->GetExtension() == "pchtxt") {
-            LOG_INFO(Loader, "    - Applying IPSwitch patch from mod \"{}\"",
-                     patch_file->GetContainingDirectory()->GetParentDirectory()->GetName());
-            const IPSwitchCompiler compiler{patch_file};
-            const auto patched = compiler.Apply(std::make_shared<VectorVfsFile>(out));
-            if (patched != nullptr)
-                out = patched->ReadAllBytes();
+        const auto mod_name = patch_file->GetContainingDirectory()->GetParentDirectory()->GetName();
+        auto compiled = GetCompiledPatch(patch_file);
+        if (compiled == nullptr) {
+            LOG_WARNING(Loader, "    - Skipping invalid patch \"{}\" from mod \"{}\"",
+                        patch_file->GetName(), mod_name);
+            continue;
         }
+        LOG_INFO(Loader, "    - Applying {} patch from mod \"{}\"",
+                 patch_file->GetExtension() == "ips" ? "IPS" : "IPSwitch", mod_name);
+        compiled_patches.push_back(std::move(compiled));
     }
+    std::vector<const CompiledPatch*> patch_list(compiled_patches.size());
+    std::ranges::transform(compiled_patches, patch_list.begin(),
+                           [](const auto& compiled) { return compiled.get(); });
+    auto out = nso;
+    ApplyPatches(out, patch_list);
     if (out.size() < sizeof(Loader::NSOHeader)) {
         return nso;
     }
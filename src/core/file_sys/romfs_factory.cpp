@@ -11,6 +11,7 @@
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs_factory.h"
+#include "core/file_sys/shared_romfs_cache.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/service/filesystem/filesystem.h"
 #include "core/loader/loader.h"
@@ -18,13 +19,19 @@
 namespace FileSys {
 
 RomFSFactory::RomFSFactory(Loader::AppLoader& app_loader, ContentProvider& provider,
-                           Service::FileSystem::FileSystemController& controller)
+                           Service::FileSystem::FileSystemController& controller,
+                           std::span<const u8> build_id)
     : content_provider{provider}, filesystem_controller{controller} {
     // Load the RomFS from the app
     if (app_loader.ReadRomFS(file) != Loader::ResultStatus::Success) {
         LOG_WARNING(Service_FS, "Unable to read base RomFS");
     }
 
+    u64 program_id{};
+    if (file != nullptr && app_loader.ReadProgramId(program_id) == Loader::ResultStatus::Success) {
+        file = OpenSharedRomFS(program_id, build_id, file);
+    }
+
     updatable = app_loader.IsRomFSUpdatable();
 }
 
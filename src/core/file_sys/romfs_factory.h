@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "common/common_types.h"
 #include "core/file_sys/vfs/vfs_types.h"
@@ -37,7 +38,8 @@ enum class StorageId : u8 {
 class RomFSFactory {
 public:
     explicit RomFSFactory(Loader::AppLoader& app_loader, ContentProvider& provider,
-                          Service::FileSystem::FileSystemController& controller);
+                          Service::FileSystem::FileSystemController& controller,
+                          std::span<const u8> build_id);
     ~RomFSFactory();
 
     void SetPackedUpdate(VirtualFile packed_update_raw);
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/cityhash.h"
+#include "common/fs/file.h"
+#include "common/fs/file_lock.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/hex_util.h"
+#include "common/literals.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+#include "core/file_sys/shared_romfs_cache.h"
+#include "core/file_sys/vfs/vfs.h"
+#include "core/file_sys/vfs/vfs_real.h"
+
+namespace FileSys {
+namespace {
+using namespace Common::Literals;
+
+constexpr size_t COPY_BLOCK_SIZE = 8_MiB;
+constexpr size_t KEY_HASH_SIZE = 0x1000;
+
+/// Identifies a RomFS by its title, the build ID of the running executable, its size and a hash
+/// of its header and first metadata tables. The build ID changes with every release of a title,
+/// so a revised RomFS does not reuse the copy cached for an earlier one.
+std::string MakeCacheKey(u64 program_id, std::span<const u8> build_id, const VirtualFile& romfs) {
+    const auto build_id_raw = Common::HexToString(build_id);
+    const auto build_id_hex = build_id_raw.substr(0, build_id_raw.find_last_not_of('0') + 1);
+    const auto head = romfs->ReadBytes(std::min(romfs->GetSize(), KEY_HASH_SIZE));
+    const u64 hash = Common::CityHash64(reinterpret_cast<const char*>(head.data()), head.size());
+    return fmt::format("{:016X}-{}-{:X}-{:016X}", program_id, build_id_hex, romfs->GetSize(),
+                       hash);
+}
+
+bool CopyToFile(const VirtualFile& romfs, const std::filesystem::path& path) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    if (!file.IsOpen()) {
+        return false;
+    }
+    std::vector<u8> buffer(std::min(romfs->GetSize(), COPY_BLOCK_SIZE));
+    for (size_t offset = 0; offset < romfs->GetSize(); offset += buffer.size()) {
+        const size_t read = romfs->Read(buffer.data(), buffer.size(), offset);
+        if (read == 0 || file.WriteSpan(std::span<const u8>(buffer.data(), read)) != read) {
+            return false;
+        }
+    }
+    return file.Flush();
+}
+} // Anonymous namespace
+
+VirtualFile OpenSharedRomFS(u64 program_id, std::span<const u8> build_id,
+                            const VirtualFile& romfs) {
+    if (!Settings::values.shared_cache.GetValue() || romfs == nullptr || romfs->GetSize() == 0) {
+        return romfs;
+    }
+
+    const auto cache_dir = Common::FS::GetCitronPath(Common::FS::CitronPath::CacheDir) / "shared";
+    if (!Common::FS::CreateDirs(cache_dir)) {
+        return romfs;
+    }
+    const auto key = MakeCacheKey(program_id, build_id, romfs);
+    const auto path = cache_dir / fmt::format("{}.romfs", key);
+
+    // The cached file is renamed into place once complete, so it can be used whenever it exists.
+    // Only the first instance copies it, the others wait on the lock.
+    if (!Common::FS::Exists(path)) {
+        const Common::FS::FileLock lock{cache_dir / fmt::format("{}.lock", key),
+                                        Common::FS::FileLockMode::Exclusive};
+        if (!Common::FS::Exists(path)) {
+            LOG_INFO(Loader, "Populating shared RomFS cache for title_id={:016X}", program_id);
+            auto temp_path = path;
+            temp_path += ".tmp";
+            if (!CopyToFile(romfs, temp_path) || !Common::FS::RenameFile(temp_path, path)) {
+                LOG_ERROR(Loader, "Failed to populate shared RomFS cache at {}",
+                          Common::FS::PathToUTF8String(path));
+                Common::FS::RemoveFile(temp_path);
+                return romfs;
+            }
+        }
+    }
+
+    static RealVfsFilesystem shared_filesystem;
+    auto cached = shared_filesystem.OpenFile(Common::FS::PathToUTF8String(path), OpenMode::Read);
+    if (cached == nullptr || cached->GetSize() != romfs->GetSize()) {
+        LOG_WARNING(Loader, "Shared RomFS cache at {} is unusable",
+                    Common::FS::PathToUTF8String(path));
+        return romfs;
+    }
+    LOG_INFO(Loader, "Using shared RomFS cache for title_id={:016X}", program_id);
+    return cached;
+}
+
+} // namespace FileSys
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs/vfs_types.h"
+
+namespace FileSys {
+
+/**
+ * Returns the decrypted RomFS from the shared cache directory, populating it on first use.
+ * Instances of the same title then read the RomFS through the host page cache instead of each
+ * decrypting their own copy. The cached copy is keyed by program_id and build_id so that every
+ * release of a title gets its own. Returns romfs unchanged when the shared cache is disabled or
+ * the cached copy can not be created.
+ */
+VirtualFile OpenSharedRomFS(u64 program_id, std::span<const u8> build_id,
+                            const VirtualFile& romfs);
+
+} // namespace FileSys
@@ -213,6 +213,9 @@ class KScopedAutoObject {
 public:
     CITRON_NON_COPYABLE(KScopedAutoObject);
 
+    struct AdoptReferenceTag {};
+    static constexpr AdoptReferenceTag AdoptReference{};
+
     constexpr KScopedAutoObject() = default;
 
     constexpr KScopedAutoObject(T* o) : m_obj(o) {
@@ -221,6 +224,9 @@ public:
         }
     }
 
+    // Takes over a reference that the caller has already opened.
+    constexpr KScopedAutoObject(T* o, AdoptReferenceTag) : m_obj(o) {}
+
     ~KScopedAutoObject() {
         if (m_obj != nullptr) {
             m_obj->Close();
@@ -13,7 +13,7 @@ Result KHandleTable::Finalize() {
         KScopedDisableDispatch dd{m_kernel};
         KScopedSpinLock lk(m_lock);
 
-        std::swap(m_table_size, saved_table_size);
+        saved_table_size = m_table_size.exchange(0);
     }
 
     // Close and free all entries.
@@ -72,10 +72,8 @@ Result KHandleTable::Add(Handle* out_handle, KAutoObject* obj) {
         const auto linear_id = this->AllocateLinearId();
         const auto index = this->AllocateEntry();
 
-        m_entry_infos[index].linear_id = linear_id;
-        m_objects[index] = obj;
-
         obj->Open();
+        this->PublishEntry(index, linear_id, obj);
 
         *out_handle = EncodeHandle(static_cast<u16>(index), linear_id);
     }
@@ -145,10 +143,8 @@ void KHandleTable::Register(Handle handle, KAutoObject* obj) {
         // Set the entry.
         ASSERT(m_objects[index] == nullptr);
 
-        m_entry_infos[index].linear_id = static_cast<u16>(linear_id);
-        m_objects[index] = obj;
-
         obj->Open();
+        this->PublishEntry(index, static_cast<u16>(linear_id), obj);
     }
 }
 
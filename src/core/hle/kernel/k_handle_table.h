@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include "common/assert.h"
 #include "common/bit_field.h"
@@ -48,6 +49,7 @@ public:
         // Free all entries.
         for (s32 i = 0; i < static_cast<s32>(m_table_size); ++i) {
             m_objects[i] = nullptr;
+            m_entry_tags[i] = 0;
             m_entry_infos[i].next_free_index = static_cast<s16>(i - 1);
             m_free_head_index = i;
         }
@@ -70,16 +72,19 @@ public:
 
     template <typename T = KAutoObject>
     KScopedAutoObject<T> GetObjectWithoutPseudoHandle(Handle handle) const {
-        // Lock and look up in table.
-        KScopedDisableDispatch dd{m_kernel};
-        KScopedSpinLock lk(m_lock);
+        // Look up in table, without locking.
+        KAutoObject* obj = this->OpenObjectImpl(handle);
+        if (obj == nullptr) [[unlikely]] {
+            return nullptr;
+        }
 
         if constexpr (std::is_same_v<T, KAutoObject>) {
-            return this->GetObjectImpl(handle);
+            return KScopedAutoObject<T>(obj, KScopedAutoObject<T>::AdoptReference);
         } else {
-            if (auto* obj = this->GetObjectImpl(handle); obj != nullptr) [[likely]] {
-                return obj->DynamicCast<T*>();
+            if (T* derived = obj->DynamicCast<T*>(); derived != nullptr) [[likely]] {
+                return KScopedAutoObject<T>(derived, KScopedAutoObject<T>::AdoptReference);
             } else {
+                obj->Close();
                 return nullptr;
             }
         }
@@ -106,11 +111,9 @@ public:
     }
 
     KScopedAutoObject<KAutoObject> GetObjectForIpcWithoutPseudoHandle(Handle handle) const {
-        // Lock and look up in table.
-        KScopedDisableDispatch dd{m_kernel};
-        KScopedSpinLock lk(m_lock);
-
-        return this->GetObjectImpl(handle);
+        // Look up in table, without locking.
+        return KScopedAutoObject<KAutoObject>(this->OpenObjectImpl(handle),
+                                              KScopedAutoObject<KAutoObject>::AdoptReference);
     }
 
     KScopedAutoObject<KAutoObject> GetObjectForIpc(Handle handle, KThread* cur_thread) const;
@@ -132,30 +135,21 @@ public:
     bool GetMultipleObjects(T** out, const Handle* handles, size_t num_handles) const {
         // Try to convert and open all the handles.
         size_t num_opened;
-        {
-            // Lock the table.
-            KScopedDisableDispatch dd{m_kernel};
-            KScopedSpinLock lk(m_lock);
-            for (num_opened = 0; num_opened < num_handles; num_opened++) {
-                // Get the current handle.
-                const auto cur_handle = handles[num_opened];
-
-                // Get the object for the current handle.
-                KAutoObject* cur_object = this->GetObjectImpl(cur_handle);
-                if (cur_object == nullptr) [[unlikely]] {
-                    break;
-                }
-
-                // Cast the current object to the desired type.
-                T* cur_t = cur_object->DynamicCast<T*>();
-                if (cur_t == nullptr) [[unlikely]] {
-                    break;
-                }
-
-                // Open a reference to the current object.
-                cur_t->Open();
-                out[num_opened] = cur_t;
+        for (num_opened = 0; num_opened < num_handles; num_opened++) {
+            // Get and open the object for the current handle.
+            KAutoObject* cur_object = this->OpenObjectImpl(handles[num_opened]);
+            if (cur_object == nullptr) [[unlikely]] {
+                break;
             }
+
+            // Cast the current object to the desired type.
+            T* cur_t = cur_object->DynamicCast<T*>();
+            if (cur_t == nullptr) [[unlikely]] {
+                cur_object->Close();
+                break;
+            }
+
+            out[num_opened] = cur_t;
         }
 
         // If we converted every object, succeed.
@@ -187,7 +181,9 @@ private:
     void FreeEntry(s32 index) {
         ASSERT(m_count > 0);
 
-        m_objects[index] = nullptr;
+        // Invalidate the entry for lock-free readers before clearing it.
+        m_entry_tags[index].store(MakeEntryTag(index, 0), std::memory_order_release);
+        m_objects[index].store(nullptr, std::memory_order_relaxed);
         m_entry_infos[index].next_free_index = static_cast<s16>(m_free_head_index);
 
         m_free_head_index = index;
@@ -195,6 +191,20 @@ private:
         --m_count;
     }
 
+    void PublishEntry(s32 index, u16 linear_id, KAutoObject* obj) {
+        m_entry_infos[index].linear_id = linear_id;
+        m_objects[index].store(obj, std::memory_order_relaxed);
+        m_entry_tags[index].store(MakeEntryTag(index, linear_id), std::memory_order_release);
+    }
+
+    /// Entry tags pair the linear id of an entry with a generation that changes on every
+    /// update, so lock-free readers can tell whether the entry changed while they used it.
+    /// Must be called with the lock held.
+    u32 MakeEntryTag(s32 index, u16 linear_id) const {
+        const u32 generation = (m_entry_tags[index].load(std::memory_order_relaxed) >> 16) + 1;
+        return (generation << 16) | linear_id;
+    }
+
     u16 AllocateLinearId() {
         const u16 id = m_next_linear_id++;
         if (m_next_linear_id > MaxLinearId) {
@@ -248,6 +258,53 @@ private:
         }
     }
 
+    /// Looks up and opens the object of a handle without taking the lock. The entry tag is
+    /// checked again once the object is opened, if the entry changed in between the object may
+    /// have been destroyed and its slab slot reused, so the lookup is redone under the lock.
+    /// Opening a stale object is harmless, as slab memory stays mapped and a destroyed object
+    /// has no references left to take.
+    KAutoObject* OpenObjectImpl(Handle handle) const {
+        // Handles must not have reserved bits set.
+        const auto handle_pack = HandlePack(handle);
+        if (handle_pack.reserved != 0) [[unlikely]] {
+            return nullptr;
+        }
+
+        // Validate our indexing information.
+        const auto index = handle_pack.index;
+        const auto linear_id = handle_pack.linear_id;
+        if (linear_id == 0) [[unlikely]] {
+            return nullptr;
+        }
+        if (index >= m_table_size.load(std::memory_order_relaxed)) [[unlikely]] {
+            return nullptr;
+        }
+
+        // Check that the entry holds the object our serial id refers to.
+        const u32 tag = m_entry_tags[index].load(std::memory_order_acquire);
+        if ((tag & 0xFFFF) != linear_id) [[unlikely]] {
+            return nullptr;
+        }
+        if (KAutoObject* obj = m_objects[index].load(std::memory_order_relaxed);
+            obj != nullptr && obj->Open()) [[likely]] {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_entry_tags[index].load(std::memory_order_relaxed) == tag) [[likely]] {
+                return obj;
+            }
+            obj->Close();
+        }
+
+        // The entry changed while we were reading it, settle the lookup under the lock.
+        KScopedDisableDispatch dd{m_kernel};
+        KScopedSpinLock lk(m_lock);
+
+        KAutoObject* obj = this->GetObjectImpl(handle);
+        if (obj != nullptr) {
+            obj->Open();
+        }
+        return obj;
+    }
+
     KAutoObject* GetObjectByIndexImpl(Handle* out_handle, size_t index) const {
         // Index must be in bounds.
         if (index >= m_table_size) [[unlikely]] {
@@ -301,10 +358,11 @@ private:
 private:
     KernelCore& m_kernel;
     std::array<EntryInfo, MaxTableSize> m_entry_infos{};
-    std::array<KAutoObject*, MaxTableSize> m_objects{};
+    std::array<std::atomic<KAutoObject*>, MaxTableSize> m_objects{};
+    std::array<std::atomic<u32>, MaxTableSize> m_entry_tags{};
     mutable KSpinLock m_lock;
     s32 m_free_head_index{};
-    u16 m_table_size{};
+    std::atomic<u16> m_table_size{};
     u16 m_max_count{};
     u16 m_next_linear_id{};
     u16 m_count{};
@@ -1,8 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
 #include "common/scope_exit.h"
 #include "common/settings.h"
+#include "common/spin_lock.h"
 #include "citron/util/title_ids.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
@@ -14,6 +19,13 @@
 #include "core/hle/kernel/svc.h"
 
 namespace Kernel {
+namespace {
+s64 GetTimeNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+} // Anonymous namespace
 
 PhysicalCore::PhysicalCore(KernelCore& kernel, std::size_t core_index)
     : m_kernel{kernel}, m_core_index{core_index} {
@@ -269,12 +281,52 @@ void PhysicalCore::LogBacktrace() {
 }
 
 void PhysicalCore::Idle() {
-    std::unique_lock lk{m_guard};
-    m_on_interrupt.wait(lk, [this] { return m_is_interrupted; });
+    // Spin for a short while before parking the host thread, interrupts frequently arrive
+    // right after a core goes idle and waking a parked thread takes much longer.
+    bool woke_while_spinning{false};
+    for (u32 i = 0; i < m_idle_spin_iterations; ++i) {
+        if (m_is_interrupted.load(std::memory_order_acquire)) {
+            woke_while_spinning = true;
+            break;
+        }
+        Common::ThreadPause();
+    }
+
+    if (woke_while_spinning) {
+        m_idle_spin_iterations = std::min(m_idle_spin_iterations * 2, MaxIdleSpinIterations);
+    } else {
+        m_idle_spin_iterations = std::max(m_idle_spin_iterations / 2, MinIdleSpinIterations);
+        while (!m_is_interrupted.load(std::memory_order_acquire)) {
+            m_is_interrupted.wait(false, std::memory_order_acquire);
+        }
+    }
+
+    RecordWakeupLatency(woke_while_spinning);
+}
+
+void PhysicalCore::RecordWakeupLatency(bool woke_while_spinning) {
+    const s64 latency_ns = GetTimeNs() - m_interrupt_time.load(std::memory_order_relaxed);
+    const u64 latency_us = static_cast<u64>(std::max<s64>(latency_ns, 0)) / 1000;
+    const std::size_t bucket =
+        std::min<std::size_t>(std::bit_width(latency_us), NumWakeupLatencyBuckets - 1);
+    m_wakeup_latency_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    auto& wakeups = woke_while_spinning ? m_spin_wakeups : m_sleep_wakeups;
+    wakeups.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool PhysicalCore::IsInterrupted() const {
-    return m_is_interrupted;
+    return m_is_interrupted.load(std::memory_order_acquire);
+}
+
+PhysicalCore::WakeupLatencyStatistics PhysicalCore::GetWakeupLatencyStatistics() const {
+    WakeupLatencyStatistics statistics{};
+    for (std::size_t i = 0; i < NumWakeupLatencyBuckets; ++i) {
+        statistics.histogram[i] = m_wakeup_latency_histogram[i].load(std::memory_order_relaxed);
+    }
+    statistics.spin_wakeups = m_spin_wakeups.load(std::memory_order_relaxed);
+    statistics.sleep_wakeups = m_sleep_wakeups.load(std::memory_order_relaxed);
+    return statistics;
 }
 
 void PhysicalCore::Interrupt() {
@@ -285,11 +337,14 @@ void PhysicalCore::Interrupt() {
     auto* arm_interface = m_arm_interface;
     auto* thread = m_current_thread;
 
-    // Add interrupt flag.
-    m_is_interrupted = true;
+    // Add interrupt flag, remembering when it was raised to measure the wakeup latency.
+    if (!m_is_interrupted.load(std::memory_order_relaxed)) {
+        m_interrupt_time.store(GetTimeNs(), std::memory_order_relaxed);
+    }
+    m_is_interrupted.store(true, std::memory_order_release);
 
     // Interrupt ourselves.
-    m_on_interrupt.notify_one();
+    m_is_interrupted.notify_one();
 
     // If there is no thread running, we are done.
     if (arm_interface == nullptr) {
@@ -302,7 +357,7 @@ void PhysicalCore::Interrupt() {
 
 void PhysicalCore::ClearInterrupt() {
     std::scoped_lock lk{m_guard};
-    m_is_interrupted = false;
+    m_is_interrupted.store(false, std::memory_order_relaxed);
 }
 
 } // namespace Kernel
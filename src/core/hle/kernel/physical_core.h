@@ -3,7 +3,8 @@
 
 #pragma once
 
-#include <condition_variable>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -23,6 +24,15 @@ namespace Kernel {
 
 class PhysicalCore {
 public:
+    static constexpr std::size_t NumWakeupLatencyBuckets = 16;
+
+    struct WakeupLatencyStatistics {
+        /// Wakeups bucketed by interrupt-to-run latency, bucket N holds latencies below 2^N us
+        std::array<u64, NumWakeupLatencyBuckets> histogram{};
+        u64 spin_wakeups{};  ///< Wakeups observed while spinning
+        u64 sleep_wakeups{}; ///< Wakeups that had to unpark the host thread
+    };
+
     PhysicalCore(KernelCore& kernel, std::size_t core_index);
     ~PhysicalCore();
 
@@ -58,20 +68,34 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Get the distribution of latencies between an interrupt and the idle core resuming.
+    WakeupLatencyStatistics GetWakeupLatencyStatistics() const;
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
 
 private:
+    static constexpr u32 MinIdleSpinIterations = 16;
+    static constexpr u32 MaxIdleSpinIterations = 4096;
+
+    void RecordWakeupLatency(bool woke_while_spinning);
+
     KernelCore& m_kernel;
     const std::size_t m_core_index;
 
     std::mutex m_guard;
-    std::condition_variable m_on_interrupt;
     Core::ArmInterface* m_arm_interface{};
     KThread* m_current_thread{};
-    bool m_is_interrupted{};
+    std::atomic<bool> m_is_interrupted{};
     bool m_is_single_core{};
+
+    // Idle spin budget, grows when interrupts arrive while spinning and shrinks otherwise.
+    u32 m_idle_spin_iterations{MinIdleSpinIterations};
+    std::atomic<s64> m_interrupt_time{};
+    std::array<std::atomic<u64>, NumWakeupLatencyBuckets> m_wakeup_latency_histogram{};
+    std::atomic<u64> m_spin_wakeups{};
+    std::atomic<u64> m_sleep_wakeups{};
 };
 
 } // namespace Kernel
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "common/fs/file.h"
@@ -41,6 +43,9 @@ Result AlbumManager::DeleteAlbumFile(const AlbumFileId& file_id) {
         return ResultFileNotFound;
     }
 
+    std::scoped_lock lock{album_mutex};
+    album_files.erase(file_id);
+    thumbnail_cache.erase(file_id);
     return ResultSuccess;
 }
 
@@ -52,7 +57,15 @@ Result AlbumManager::IsAlbumMounted(AlbumStorage storage) {
     is_mounted = true;
 
     if (storage == AlbumStorage::Sd) {
-        FindScreenshots();
+        // Only rescan when files were added or removed since the directory was indexed
+        const auto screenshots_dir =
+            Common::FS::GetCitronPath(Common::FS::CitronPath::ScreenshotsDir);
+        std::error_code ec;
+        const auto write_time = std::filesystem::last_write_time(screenshots_dir, ec);
+        if (!is_indexed || ec || write_time != indexed_write_time) {
+            FindScreenshots();
+            indexed_write_time = write_time;
+        }
     }
 
     return is_mounted ? ResultSuccess : ResultIsNotMounted;
@@ -68,7 +81,8 @@ Result AlbumManager::GetAlbumFileList(std::span<AlbumEntry> out_entries, u64& ou
         return ResultIsNotMounted;
     }
 
-    for (auto& [file_id, path] : album_files) {
+    std::scoped_lock lock{album_mutex};
+    for (const auto& [file_id, file] : album_files) {
         if (file_id.storage != storage) {
             continue;
         }
@@ -79,9 +93,8 @@ Result AlbumManager::GetAlbumFileList(std::span<AlbumEntry> out_entries, u64& ou
             break;
         }
 
-        const auto entry_size = Common::FS::GetSize(path);
         out_entries[out_entries_count++] = {
-            .entry_size = entry_size,
+            .entry_size = file.size,
             .file_id = file_id,
         };
     }
@@ -125,7 +138,8 @@ Result AlbumManager::GetAlbumFileList(std::span<ApplicationAlbumEntry> out_entri
         return ResultIsNotMounted;
     }
 
-    for (auto& [file_id, path] : album_files) {
+    std::scoped_lock lock{album_mutex};
+    for (const auto& [file_id, file] : album_files) {
         if (file_id.type != content_type) {
             continue;
         }
@@ -142,9 +156,8 @@ Result AlbumManager::GetAlbumFileList(std::span<ApplicationAlbumEntry> out_entri
             break;
         }
 
-        const auto entry_size = Common::FS::GetSize(path);
         out_entries[out_entries_count++] = {
-            .size = entry_size,
+            .size = file.size,
             .hash{},
             .datetime = file_id.date,
             .storage = file_id.storage,
@@ -222,6 +235,16 @@ Result AlbumManager::LoadAlbumScreenShotThumbnail(
         .pad179{},
     };
 
+    {
+        std::scoped_lock lock{album_mutex};
+        const auto it = thumbnail_cache.find(file_id);
+        if (it != thumbnail_cache.end() && it->second.flag == decoder_options.flags &&
+            it->second.image.size() == out_image.size()) {
+            std::ranges::copy(it->second.image, out_image.begin());
+            return ResultSuccess;
+        }
+    }
+
     std::filesystem::path path;
     const auto result = GetFile(path, file_id);
 
@@ -229,8 +252,23 @@ Result AlbumManager::LoadAlbumScreenShotThumbnail(
         return result;
     }
 
-    return LoadImage(out_image, path, static_cast<int>(out_image_output.width),
-                     +static_cast<int>(out_image_output.height), decoder_options.flags);
+    const auto load_result =
+        LoadImage(out_image, path, static_cast<int>(out_image_output.width),
+                  +static_cast<int>(out_image_output.height), decoder_options.flags);
+
+    if (load_result.IsError()) {
+        return load_result;
+    }
+
+    std::scoped_lock lock{album_mutex};
+    if (thumbnail_cache.size() >= ThumbnailCacheLimit) {
+        thumbnail_cache.clear();
+    }
+    thumbnail_cache.insert_or_assign(file_id, CachedThumbnail{
+                                                  .flag = decoder_options.flags,
+                                                  .image{out_image.begin(), out_image.end()},
+                                              });
+    return ResultSuccess;
 }
 
 Result AlbumManager::SaveScreenShot(ApplicationAlbumEntry& out_entry,
@@ -288,19 +326,36 @@ Result AlbumManager::SaveEditedScreenShot(ApplicationAlbumEntry& out_entry,
 }
 
 Result AlbumManager::GetFile(std::filesystem::path& out_path, const AlbumFileId& file_id) const {
+    std::scoped_lock lock{album_mutex};
     const auto file = album_files.find(file_id);
 
     if (file == album_files.end()) {
         return ResultFileNotFound;
     }
 
-    out_path = file->second;
+    out_path = file->second.path;
     return ResultSuccess;
 }
 
+void AlbumManager::AddAlbumFile(AlbumFileId file_id, std::filesystem::path path, u64 size) {
+    while (album_files.contains(file_id)) {
+        if (++file_id.date.unique_id == 0) {
+            break;
+        }
+    }
+    thumbnail_cache.erase(file_id);
+    album_files.insert_or_assign(file_id, AlbumFile{
+                                              .path = std::move(path),
+                                              .size = size,
+                                          });
+}
+
 void AlbumManager::FindScreenshots() {
     is_mounted = false;
+
+    std::scoped_lock lock{album_mutex};
     album_files.clear();
+    thumbnail_cache.clear();
 
     // TODO: Swap this with a blocking operation.
     const auto screenshots_dir = Common::FS::GetCitronPath(Common::FS::CitronPath::ScreenshotsDir);
@@ -311,16 +366,12 @@ void AlbumManager::FindScreenshots() {
             if (GetAlbumEntry(entry, full_path).IsError()) {
                 return true;
             }
-            while (album_files.contains(entry.file_id)) {
-                if (++entry.file_id.date.unique_id == 0) {
-                    break;
-                }
-            }
-            album_files[entry.file_id] = full_path;
+            AddAlbumFile(entry.file_id, full_path, Common::FS::GetSize(full_path));
             return true;
         },
         Common::FS::DirEntryFilter::File);
 
+    is_indexed = true;
     is_mounted = true;
 }
 
@@ -426,17 +477,17 @@ Result AlbumManager::LoadImage(std::span<u8> out_image, const std::filesystem::p
 }
 
 void AlbumManager::FlipVerticallyOnWrite(bool flip) {
-    stbi_flip_vertically_on_write(flip);
+    flip_on_write = flip;
 }
 
 static void PNGToMemory(void* context, void* data, int len) {
     std::vector<u8>* png_image = static_cast<std::vector<u8>*>(context);
-    unsigned char* png = static_cast<unsigned char*>(data);
+    const u8* png = static_cast<const u8*>(data);
     png_image->insert(png_image->end(), png, png + len);
 }
 
 Result AlbumManager::SaveImage(ApplicationAlbumEntry& out_entry, std::span<const u8> image,
-                               u64 title_id, const AlbumFileDateTime& date) const {
+                               u64 title_id, const AlbumFileDateTime& date) {
     const auto screenshot_path =
         Common::FS::GetCitronPathString(Common::FS::CitronPath::ScreenshotsDir);
     const std::string formatted_date =
@@ -445,19 +496,50 @@ Result AlbumManager::SaveImage(ApplicationAlbumEntry& out_entry, std::span<const
     const std::string file_path =
         fmt::format("{}/{:016x}_{}.png", screenshot_path, title_id, formatted_date);
 
-    const Common::FS::IOFile db_file{file_path, Common::FS::FileAccessMode::Write,
-                                     Common::FS::FileType::BinaryFile};
+    const AlbumFileId file_id{
+        .application_id = title_id,
+        .date = date,
+        .storage = AlbumStorage::Sd,
+        .type = ContentType::Screenshot,
+        .unknown = 1,
+    };
+
+    constexpr std::size_t row_size = 1280 * STBI_rgb_alpha;
+    if (image.size() < row_size * 720) {
+        return ResultFileCountLimit;
+    }
+
+    // stb only flips through a global flag, flip a copy of the rows instead so that screenshots
+    // saved from the renderer thread and the service thread can't affect each other
+    std::vector<u8> flipped_image;
+    const u8* image_data = image.data();
+    if (flip_on_write) {
+        flipped_image.resize(row_size * 720);
+        for (std::size_t row = 0; row < 720; ++row) {
+            std::memcpy(flipped_image.data() + row * row_size,
+                        image.data() + (719 - row) * row_size, row_size);
+        }
+        image_data = flipped_image.data();
+    }
 
     std::vector<u8> png_image;
-    if (!stbi_write_png_to_func(PNGToMemory, &png_image, 1280, 720, STBI_rgb_alpha, image.data(),
+    png_image.reserve(image.size() / 2);
+    if (!stbi_write_png_to_func(PNGToMemory, &png_image, 1280, 720, STBI_rgb_alpha, image_data,
                                 0)) {
         return ResultFileCountLimit;
     }
 
+    const Common::FS::IOFile db_file{file_path, Common::FS::FileAccessMode::Write,
+                                     Common::FS::FileType::BinaryFile};
     if (db_file.Write(png_image) != png_image.size()) {
         return ResultFileCountLimit;
     }
 
+    {
+        std::scoped_lock lock{album_mutex};
+        AddAlbumFile(file_id, file_path, png_image.size());
+    }
+
     out_entry = {
         .size = png_image.size(),
         .hash = {},
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <filesystem>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "common/fs/fs.h"
 #include "core/hle/result.h"
@@ -73,19 +77,42 @@ public:
 private:
     static constexpr std::size_t NandAlbumFileLimit = 1000;
     static constexpr std::size_t SdAlbumFileLimit = 10000;
+    static constexpr std::size_t ThumbnailCacheLimit = 32;
+
+    struct AlbumFile {
+        std::filesystem::path path;
+        u64 size;
+    };
+
+    struct CachedThumbnail {
+        ScreenShotDecoderFlag flag;
+        std::vector<u8> image;
+    };
 
     void FindScreenshots();
+    void AddAlbumFile(AlbumFileId file_id, std::filesystem::path path, u64 size);
     Result GetFile(std::filesystem::path& out_path, const AlbumFileId& file_id) const;
     Result GetAlbumEntry(AlbumEntry& out_entry, const std::filesystem::path& path) const;
     Result LoadImage(std::span<u8> out_image, const std::filesystem::path& path, int width,
                      int height, ScreenShotDecoderFlag flag) const;
     Result SaveImage(ApplicationAlbumEntry& out_entry, std::span<const u8> image, u64 title_id,
-                     const AlbumFileDateTime& date) const;
+                     const AlbumFileDateTime& date);
 
     AlbumFileDateTime ConvertToAlbumDateTime(u64 posix_time) const;
 
     bool is_mounted{};
-    std::unordered_map<AlbumFileId, std::filesystem::path> album_files;
+    bool is_indexed{};
+    std::atomic<bool> flip_on_write{};
+
+    /// Write time of the screenshots directory when it was indexed, the frontend saves
+    /// screenshots there without going through the album manager
+    std::filesystem::file_time_type indexed_write_time{};
+
+    /// Protects the album index and the thumbnail cache, screenshots are also saved from the
+    /// renderer thread
+    mutable std::mutex album_mutex;
+    std::unordered_map<AlbumFileId, AlbumFile> album_files;
+    mutable std::unordered_map<AlbumFileId, CachedThumbnail> thumbnail_cache;
 
     Core::System& system;
 };
@@ -70,20 +70,65 @@ NvResult NvMap::Handle::Duplicate(bool internal_session) {
     return NvResult::Success;
 }
 
-NvMap::NvMap(Container& core_, Tegra::Host1x::Host1x& host1x_) : host1x{host1x_}, core{core_} {}
+NvMap::NvMap(Container& core_, Tegra::Host1x::Host1x& host1x_) : host1x{host1x_}, core{core_} {
+    // Slot 0 would produce a null handle ID, keep it reserved
+    handle_shards[0].next_index = 1;
+}
+
+NvMap::~NvMap() {
+    // Queued handles reference themselves, drop those references so they can be freed
+    unmap_queue.clear_and_dispose([](Handle* handle) { handle->unmap_queue_ref.reset(); });
+}
+
+std::shared_ptr<NvMap::Handle>* NvMap::FindSlot(HandleShard& shard, Handle::Id id) {
+    const size_t index{HandleSlot(id) / HandleShardCount};
+    if (index >= shard.slots.size()) {
+        return nullptr;
+    }
+    auto& slot{shard.slots[index]};
+    // The ID also carries the slot generation, a stale ID will not match the current handle
+    if (!slot || slot->id != id) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+std::shared_ptr<NvMap::Handle> NvMap::AddHandle(u64 size) {
+    const u32 shard_index{next_shard.fetch_add(1, std::memory_order_relaxed) % HandleShardCount};
+    HandleShard& shard{handle_shards[shard_index]};
+    std::scoped_lock lock{shard.lock};
+
+    Handle::Id id{};
+    if (!shard.free_ids.empty()) {
+        // Reuse the slot that has been free for the longest time, this spreads generations out
+        id = shard.free_ids.front();
+        shard.free_ids.pop_front();
+    } else {
+        const u32 slot{shard.next_index * HandleShardCount + shard_index};
+        if (slot > HandleSlotMask) [[unlikely]] {
+            return nullptr;
+        }
+        ++shard.next_index;
+        shard.slots.emplace_back();
+        id = slot * HandleIdIncrement;
+    }
 
-void NvMap::AddHandle(std::shared_ptr<Handle> handle_description) {
-    std::scoped_lock lock(handles_lock);
+    auto handle_description{std::make_shared<Handle>(size, id)};
+    shard.slots[HandleSlot(id) / HandleShardCount] = handle_description;
+    return handle_description;
+}
 
-    handles.emplace(handle_description->id, std::move(handle_description));
+std::shared_ptr<NvMap::Handle> NvMap::RemoveFromUnmapQueue(Handle& handle_description) {
+    if (!handle_description.unmap_queue_hook.is_linked()) {
+        return nullptr;
+    }
+    unmap_queue.erase(unmap_queue.iterator_to(handle_description));
+    return std::move(handle_description.unmap_queue_ref);
 }
 
 void NvMap::UnmapHandle(Handle& handle_description) {
     // Remove pending unmap queue entry if needed
-    if (handle_description.unmap_queue_entry) {
-        unmap_queue.erase(*handle_description.unmap_queue_entry);
-        handle_description.unmap_queue_entry.reset();
-    }
+    RemoveFromUnmapQueue(handle_description);
 
     // Free and unmap the handle from Host1x GMMU
     if (handle_description.pin_virt_address) {
@@ -114,11 +159,19 @@ void NvMap::UnmapHandle(Handle& handle_description) {
 bool NvMap::TryRemoveHandle(const Handle& handle_description) {
     // No dupes left, we can remove from handle map
     if (handle_description.dupes == 0 && handle_description.internal_dupes == 0) {
-        std::scoped_lock lock(handles_lock);
-
-        auto it{handles.find(handle_description.id)};
-        if (it != handles.end()) {
-            handles.erase(it);
+        const Handle::Id id{handle_description.id};
+        HandleShard& shard{ShardOf(id)};
+        std::scoped_lock lock{shard.lock};
+
+        if (auto* const slot{FindSlot(shard, id)}) {
+            slot->reset();
+            // A slot whose generations are used up is retired rather than wrapped, otherwise an
+            // ID from its first generation would resolve again
+            const u32 generation{((id / HandleIdIncrement) >> HandleSlotBits) + 1};
+            if (generation <= HandleGenerationMask) {
+                const u32 next_id{(generation << HandleSlotBits) | HandleSlot(id)};
+                shard.free_ids.push_back(next_id * HandleIdIncrement);
+            }
         }
 
         return true;
@@ -132,30 +185,29 @@ NvResult NvMap::CreateHandle(u64 size, std::shared_ptr<NvMap::Handle>& result_ou
         return NvResult::BadValue;
     }
 
-    u32 id{next_handle_id.fetch_add(HandleIdIncrement, std::memory_order_relaxed)};
-    auto handle_description{std::make_shared<Handle>(size, id)};
-    AddHandle(handle_description);
+    auto handle_description{AddHandle(size)};
+    if (!handle_description) [[unlikely]] {
+        LOG_CRITICAL(Service_NVDRV, "Ran out of nvmap handle slots!");
+        return NvResult::InsufficientMemory;
+    }
 
-    result_out = handle_description;
+    result_out = std::move(handle_description);
     return NvResult::Success;
 }
 
 std::shared_ptr<NvMap::Handle> NvMap::GetHandle(Handle::Id handle) {
-    std::scoped_lock lock(handles_lock);
-    try {
-        return handles.at(handle);
-    } catch (std::out_of_range&) {
-        return nullptr;
-    }
+    HandleShard& shard{ShardOf(handle)};
+    std::shared_lock lock{shard.lock};
+    const auto* const slot{FindSlot(shard, handle)};
+    return slot ? *slot : nullptr;
 }
 
 DAddr NvMap::GetHandleAddress(Handle::Id handle) {
-    std::scoped_lock lock(handles_lock);
-    try {
-        return handles.at(handle)->d_address;
-    } catch (std::out_of_range&) {
-        return 0;
-    }
+    // Read in place, this avoids touching the reference count of the handle
+    HandleShard& shard{ShardOf(handle)};
+    std::shared_lock lock{shard.lock};
+    const auto* const slot{FindSlot(shard, handle)};
+    return slot ? (*slot)->d_address : 0;
 }
 
 DAddr NvMap::PinHandle(NvMap::Handle::Id handle, bool low_area_pin) {
@@ -183,10 +235,7 @@ DAddr NvMap::PinHandle(NvMap::Handle::Id handle, bool low_area_pin) {
             // Lock now to prevent our queue entry from being removed for allocation in-between the
             // following check and erase
             std::scoped_lock queueLock(unmap_queue_lock);
-            if (handle_description->unmap_queue_entry) {
-                unmap_queue.erase(*handle_description->unmap_queue_entry);
-                handle_description->unmap_queue_entry.reset();
-
+            if (RemoveFromUnmapQueue(*handle_description)) {
                 if (low_area_pin) {
                     map_low_area();
                     handle_description->pins++;
@@ -218,18 +267,15 @@ DAddr NvMap::PinHandle(NvMap::Handle::Id handle, bool low_area_pin) {
                 bool freed_any = false;
                 // Try to free multiple handles from the queue
                 while (!unmap_queue.empty() && free_attempts < MAX_FREE_ATTEMPTS) {
-                    if (auto freeHandleDesc{unmap_queue.front()}) {
-                        // Handles in the unmap queue are guaranteed not to be pinned so don't bother
-                        // checking if they are before unmapping
-                        std::scoped_lock freeLock(freeHandleDesc->mutex);
-                        if (freeHandleDesc->d_address) {
-                            UnmapHandle(*freeHandleDesc);
-                            freed_any = true;
-                        }
-                        // Remove from queue even if d_address was 0 (already unmapped)
-                        unmap_queue.pop_front();
-                    } else {
-                        unmap_queue.pop_front();
+                    // Take the least recently unpinned handle, the queue reference keeps it alive
+                    // until its lock has been released
+                    const auto freeHandleDesc{RemoveFromUnmapQueue(unmap_queue.front())};
+                    // Handles in the unmap queue are guaranteed not to be pinned so don't bother
+                    // checking if they are before unmapping
+                    std::scoped_lock freeLock(freeHandleDesc->mutex);
+                    if (freeHandleDesc->d_address) {
+                        UnmapHandle(*freeHandleDesc);
+                        freed_any = true;
                     }
                     free_attempts++;
                 }
@@ -271,8 +317,8 @@ void NvMap::UnpinHandle(Handle::Id handle) {
         std::scoped_lock queueLock(unmap_queue_lock);
 
         // Add to the unmap queue allowing this handle's memory to be freed if needed
-        unmap_queue.push_back(handle_description);
-        handle_description->unmap_queue_entry = std::prev(unmap_queue.end());
+        unmap_queue.push_back(*handle_description);
+        handle_description->unmap_queue_ref = handle_description;
     }
 }
 
@@ -345,19 +391,24 @@ std::optional<NvMap::FreeInfo> NvMap::FreeHandle(Handle::Id handle, bool interna
 }
 
 void NvMap::UnmapAllHandles(NvCore::SessionId session_id) {
-    auto handles_copy = [&] {
-        std::scoped_lock lk{handles_lock};
-        return handles;
-    }();
+    std::vector<std::shared_ptr<Handle>> handles_copy;
+    for (HandleShard& shard : handle_shards) {
+        std::shared_lock lk{shard.lock};
+        for (const auto& slot : shard.slots) {
+            if (slot) {
+                handles_copy.push_back(slot);
+            }
+        }
+    }
 
-    for (auto& [id, handle] : handles_copy) {
+    for (const auto& handle : handles_copy) {
         {
             std::scoped_lock lk{handle->mutex};
             if (handle->session_id.id != session_id.id || handle->dupes <= 0) {
                 continue;
             }
         }
-        FreeHandle(id, false);
+        FreeHandle(handle->id, false);
     }
 }
 
@@ -4,14 +4,18 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
-#include <list>
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <unordered_map>
+#include <shared_mutex>
+#include <vector>
 #include <assert.h>
 
+#include <boost/intrusive/list.hpp>
+
 #include "common/bit_field.h"
 #include "common/common_types.h"
 #include "core/hle/service/nvdrv/core/container.h"
@@ -53,7 +57,9 @@ public:
 
         s64 pins{};
         u32 pin_virt_address{};
-        std::optional<typename std::list<std::shared_ptr<Handle>>::iterator> unmap_queue_entry{};
+        boost::intrusive::list_member_hook<> unmap_queue_hook; //!< Links the handle into the
+                                                               //!< unmap queue while unpinned
+        std::shared_ptr<Handle> unmap_queue_ref; //!< Keeps the handle alive while it is queued
 
         union Flags {
             u32 raw;
@@ -116,6 +122,7 @@ public:
     };
 
     explicit NvMap(Container& core, Tegra::Host1x::Host1x& host1x);
+    ~NvMap();
 
     /**
      * @brief Creates an unallocated handle of the given size
@@ -155,23 +162,73 @@ public:
     void UnmapAllHandles(NvCore::SessionId session_id);
 
 private:
-    std::list<std::shared_ptr<Handle>> unmap_queue{};
-    std::mutex unmap_queue_lock{}; //!< Protects access to `unmap_queue`
+    using UnmapQueue = boost::intrusive::list<
+        Handle,
+        boost::intrusive::member_hook<Handle, boost::intrusive::list_member_hook<>,
+                                      &Handle::unmap_queue_hook>,
+        boost::intrusive::constant_time_size<false>>;
 
-    std::unordered_map<Handle::Id, std::shared_ptr<Handle>>
-        handles{};           //!< Main owning map of handles
-    std::mutex handles_lock; //!< Protects access to `handles`
+    UnmapQueue unmap_queue{};      //!< Unpinned handles in least recently unpinned order
+    std::mutex unmap_queue_lock{}; //!< Protects access to `unmap_queue`
 
     static constexpr u32 HandleIdIncrement{
-        4}; //!< Each new handle ID is an increment of 4 from the previous
-    std::atomic<u32> next_handle_id{HandleIdIncrement};
+        4}; //!< Handle IDs are always a multiple of 4, the low bits are never set
+    static constexpr u32 HandleSlotBits{20}; //!< Bits of an ID (over 4) that select the slot
+    static constexpr u32 HandleSlotMask{(1U << HandleSlotBits) - 1};
+    static constexpr u32 HandleGenerationMask{(1U << (30 - HandleSlotBits)) - 1};
+    static constexpr u32 HandleShardCount{16};
+
+    /**
+     * @brief A slice of the handle registry, slots are spread across shards so that lookups of
+     * different handles do not contend on the same lock
+     * @note The slot of a handle is `(id / HandleIdIncrement) & HandleSlotMask`, the remaining
+     * upper bits are a generation which is bumped every time the slot is reused so that stale IDs
+     * do not resolve to a newer handle. A slot is retired once its last generation is freed, so an
+     * ID is never handed out twice
+     */
+    struct alignas(64) HandleShard {
+        std::shared_mutex lock; //!< Shared for lookups, exclusive for insertion and removal
+        std::vector<std::shared_ptr<Handle>> slots; //!< Indexed by slot / HandleShardCount
+        std::deque<Handle::Id> free_ids;            //!< Next IDs of released slots, oldest first
+        u32 next_index{};                           //!< First never used index in this shard
+    };
+
+    std::array<HandleShard, HandleShardCount> handle_shards{}; //!< Main owning registry
+    std::atomic<u32> next_shard{1}; //!< Round-robins new handles across the shards
     Tegra::Host1x::Host1x& host1x;
 
-    void AddHandle(std::shared_ptr<Handle> handle);
+    static constexpr u32 HandleSlot(Handle::Id id) {
+        return (id / HandleIdIncrement) & HandleSlotMask;
+    }
+
+    HandleShard& ShardOf(Handle::Id id) {
+        return handle_shards[HandleSlot(id) % HandleShardCount];
+    }
+
+    /**
+     * @brief Finds the registry slot holding the given handle
+     * @note `shard.lock` MUST be locked (shared or exclusive) when calling this
+     * @return The slot or nullptr if no live handle has the given ID
+     */
+    static std::shared_ptr<Handle>* FindSlot(HandleShard& shard, Handle::Id id);
+
+    /**
+     * @brief Reserves a slot and registers a new handle of the given size in it
+     * @return The handle or nullptr if the registry is full
+     */
+    std::shared_ptr<Handle> AddHandle(u64 size);
+
+    /**
+     * @brief Removes a handle from the unmap queue
+     * @note `unmap_queue_lock` MUST be locked when calling this
+     * @return The reference the queue held, it must outlive any lock on the handle's mutex
+     */
+    std::shared_ptr<Handle> RemoveFromUnmapQueue(Handle& handle_description);
 
     /**
      * @brief Unmaps and frees the SMMU memory region a handle is mapped to
      * @note Both `unmap_queue_lock` and `handle_description.mutex` MUST be locked when calling this
+     * and the caller must hold its own reference to the handle
      */
     void UnmapHandle(Handle& handle_description);
 
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <cstring>
 #include "common/logging/log.h"
 #include "common/settings.h"
@@ -190,6 +191,9 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
     // Define an nce patch context for each potential module.
     PatchCollection patch_ctx{is_application};
 
+    using Clock = std::chrono::steady_clock;
+    const auto layout_start = Clock::now();
+
     // Use the NSO module loader to figure out the code layout
     for (size_t i = 0; i < static_modules.size(); i++) {
         const auto& module = static_modules[i];
@@ -228,6 +232,8 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
         return {ResultStatus::ErrorUnableToParseKernelMetadata, {}};
     }
 
+    const auto load_start = Clock::now();
+
     // Load NSO modules
     modules.clear();
     const VAddr base_address{GetInteger(process.GetEntryPoint())};
@@ -243,6 +249,7 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
 
         const VAddr load_addr{next_load_addr};
         const bool should_pass_arguments = std::strcmp(module, "rtld") == 0;
+        const auto module_start = Clock::now();
         const auto tentative_next_load_addr = AppLoader_NSO::LoadModule(
             process, system, *module_file, load_addr, should_pass_arguments, true, pm,
             patch_ctx.GetPatchers(), patch_ctx.GetIndex(i));
@@ -252,9 +259,19 @@ AppLoader_DeconstructedRomDirectory::LoadResult AppLoader_DeconstructedRomDirect
 
         next_load_addr = *tentative_next_load_addr;
         modules.insert_or_assign(load_addr, module);
-        LOG_DEBUG(Loader, "loaded module {} @ {:#X}", module, load_addr);
+        LOG_DEBUG(Loader, "loaded module {} @ {:#X} in {} us", module, load_addr,
+                  std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - module_start)
+                      .count());
     }
 
+    const auto load_end = Clock::now();
+    const auto to_ms = [](Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    };
+    LOG_INFO(Loader, "Loaded {} modules in {} ms (layout {} ms, loading {} ms)", modules.size(),
+             to_ms(load_end - layout_start), to_ms(load_start - layout_start),
+             to_ms(load_end - load_start));
+
     is_loaded = true;
     return {ResultStatus::Success,
             LoadParameters{metadata.GetMainThreadPriority(), metadata.GetMainThreadStackSize()}};
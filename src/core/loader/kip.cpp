@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <cstring>
 #include "core/file_sys/kernel_executable.h"
 #include "core/file_sys/program_metadata.h"
@@ -71,14 +72,18 @@ AppLoader::LoadResult AppLoader_KIP::Load(Kernel::KProcess& process,
                         kip->GetKernelCapabilities());
 
     Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
+    // Size the image once so segments are copied straight to their final location
+    Kernel::PhysicalMemory program_image(std::max<size_t>({
+        kip->GetTextOffset() + kip->GetTextSection().size(),
+        kip->GetRODataOffset() + kip->GetRODataSection().size(),
+        kip->GetDataOffset() + kip->GetDataSection().size(),
+    }));
 
     const auto load_segment = [&program_image](Kernel::CodeSet::Segment& segment,
                                                const std::vector<u8>& data, u32 offset) {
         segment.addr = offset;
         segment.offset = offset;
         segment.size = PageAlignSize(static_cast<u32>(data.size()));
-        program_image.resize(offset + data.size());
         std::memcpy(program_image.data() + offset, data.data(), data.size());
     };
 
@@ -77,7 +77,8 @@ AppLoader_NCA::LoadResult AppLoader_NCA::Load(Kernel::KProcess& process, Core::S
     system.GetFileSystemController().RegisterProcess(
         process.GetProcessId(), nca->GetTitleId(),
         std::make_shared<FileSys::RomFSFactory>(*this, system.GetContentProvider(),
-                                                system.GetFileSystemController()));
+                                                system.GetFileSystemController(),
+                                                system.GetApplicationProcessBuildID()));
 
     is_loaded = true;
     return load_result;
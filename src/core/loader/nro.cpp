@@ -144,22 +144,19 @@ static constexpr u32 PageAlignSize(u32 size) {
 }
 
 static bool LoadNroImpl(Core::System& system, Kernel::KProcess& process,
-                        const std::vector<u8>& data) {
-    if (data.size() < sizeof(NroHeader)) {
-        return {};
-    }
-
+                        const FileSys::VfsFile& nro_file) {
     // Read NSO header
     NroHeader nro_header{};
-    std::memcpy(&nro_header, data.data(), sizeof(NroHeader));
+    if (nro_file.ReadObject(&nro_header) != sizeof(NroHeader)) {
+        return {};
+    }
     if (nro_header.magic != Common::MakeMagic('N', 'R', 'O', '0')) {
         return {};
     }
 
-    // Build program image
+    // Build program image, reading the file straight into it
     Kernel::PhysicalMemory program_image(PageAlignSize(nro_header.file_size));
-    std::memcpy(program_image.data(), data.data(), program_image.size());
-    if (program_image.size() != PageAlignSize(nro_header.file_size)) {
+    if (nro_file.Read(program_image.data(), nro_header.file_size) != nro_header.file_size) {
         return {};
     }
 
@@ -263,7 +260,7 @@ static bool LoadNroImpl(Core::System& system, Kernel::KProcess& process,
 
 bool AppLoader_NRO::LoadNro(Core::System& system, Kernel::KProcess& process,
                             const FileSys::VfsFile& nro_file) {
-    return LoadNroImpl(system, process, nro_file.ReadAllBytes());
+    return LoadNroImpl(system, process, nro_file);
 }
 
 AppLoader_NRO::LoadResult AppLoader_NRO::Load(Kernel::KProcess& process, Core::System& system) {
@@ -280,7 +277,8 @@ AppLoader_NRO::LoadResult AppLoader_NRO::Load(Kernel::KProcess& process, Core::S
     system.GetFileSystemController().RegisterProcess(
         process.GetProcessId(), program_id,
         std::make_unique<FileSys::RomFSFactory>(*this, system.GetContentProvider(),
-                                                system.GetFileSystemController()));
+                                                system.GetFileSystemController(),
+                                                std::span<const u8>{}));
 
     is_loaded = true;
     return {ResultStatus::Success, LoadParameters{Kernel::KThread::DefaultThreadPriority,
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <cstring>
+#include <future>
 #include <vector>
 
 #include "common/common_funcs.h"
@@ -37,15 +40,15 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
+// Segments smaller than this are decompressed on the loading thread, spawning a thread for them
+// costs more than it saves
+constexpr size_t ParallelDecompressThreshold = 0x10000;
 
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
+void DecompressSegment(std::span<u8> out_data, std::span<const u8> compressed_data) {
+    const int size = Common::Compression::DecompressDataLZ4(
+        out_data.data(), out_data.size(), compressed_data.data(), compressed_data.size());
 
-    return uncompressed_data;
+    ASSERT_MSG(static_cast<size_t>(size) == out_data.size(), "{} != {}", out_data.size(), size);
 }
 
 constexpr u32 PageAlignSize(u32 size) {
@@ -105,25 +108,69 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::KProcess& process, Core::
         return 0;
     }();
 
-    // Build program image
+    // Lay out the program image from the headers, so segments can be written in place
     Kernel::CodeSet codeset;
-    Kernel::PhysicalMemory program_image;
+    size_t segments_end = module_start;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data = nso_file.ReadBytes(nso_header.segments_compressed_size[i],
-                                                  nso_header.segments[i].offset);
+        const auto& segment = nso_header.segments[i];
+        codeset.segments[i].addr = module_start + segment.location;
+        codeset.segments[i].offset = module_start + segment.location;
+        codeset.segments[i].size = segment.size;
+        segments_end =
+            std::max<size_t>(segments_end, module_start + segment.location + segment.size);
+    }
+    const bool has_arguments =
+        should_pass_arguments && !Settings::values.program_args.GetValue().empty();
+    const size_t arguments_size = has_arguments ? NSO_ARGUMENT_DATA_ALLOCATION_SIZE : 0;
+
+    // Computing the process code layout only needs the image size, unless the code is patched
+    bool needs_contents = load_into_process;
+#ifdef HAS_NCE
+    needs_contents |= patches != nullptr;
+#endif
+    if (!needs_contents) {
+        return load_base + PageAlignSize(static_cast<u32>(segments_end + arguments_size) +
+                                         nso_header.segments[2].bss_size);
+    }
+
+    // Read all segments first, files don't support concurrent reads
+    Kernel::PhysicalMemory program_image(segments_end);
+    std::array<std::vector<u8>, 3> compressed_segments;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const auto& segment = nso_header.segments[i];
         if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+            compressed_segments[i] =
+                nso_file.ReadBytes(nso_header.segments_compressed_size[i], segment.offset);
+        } else {
+            nso_file.Read(program_image.data() + codeset.segments[i].offset,
+                          std::min<size_t>(nso_header.segments_compressed_size[i], segment.size),
+                          segment.offset);
         }
-        program_image.resize(module_start + nso_header.segments[i].location +
-                             static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + module_start + nso_header.segments[i].location,
-                    data.data(), data.size());
-        codeset.segments[i].addr = module_start + nso_header.segments[i].location;
-        codeset.segments[i].offset = module_start + nso_header.segments[i].location;
-        codeset.segments[i].size = nso_header.segments[i].size;
     }
 
-    if (should_pass_arguments && !Settings::values.program_args.GetValue().empty()) {
+    // Decompress straight into the program image, large segments in parallel
+    const auto decompress = [&](std::size_t i) {
+        const std::span<u8> out_data(program_image.data() + codeset.segments[i].offset,
+                                     nso_header.segments[i].size);
+        DecompressSegment(out_data, compressed_segments[i]);
+    };
+    std::vector<std::future<void>> pending_segments;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        if (!nso_header.IsSegmentCompressed(i)) {
+            continue;
+        }
+        const bool is_last = i + 1 == nso_header.segments.size();
+        if (!is_last && compressed_segments[i].size() >= ParallelDecompressThreshold) {
+            pending_segments.push_back(std::async(std::launch::async, decompress, i));
+        } else {
+            decompress(i);
+        }
+    }
+    for (auto& pending_segment : pending_segments) {
+        pending_segment.get();
+    }
+
+    if (has_arguments) {
         const auto arg_data{Settings::values.program_args.GetValue()};
 
         codeset.DataSegment().size += NSO_ARGUMENT_DATA_ALLOCATION_SIZE;
@@ -114,7 +114,8 @@ AppLoader_NSP::LoadResult AppLoader_NSP::Load(Kernel::KProcess& process, Core::S
         system.GetFileSystemController().RegisterProcess(
             process.GetProcessId(), {},
             std::make_shared<FileSys::RomFSFactory>(*this, system.GetContentProvider(),
-                                                    system.GetFileSystemController()));
+                                                    system.GetFileSystemController(),
+                                                    system.GetApplicationProcessBuildID()));
     }
 
     FileSys::VirtualFile update_raw;
@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
+#include <span>
+
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/core.h"
@@ -90,7 +94,8 @@ u64 Freezer::Freeze(VAddr address, u32 width) {
     std::scoped_lock lock{entries_mutex};
 
     const auto current_value = MemoryReadWidth(memory, width, address);
-    entries.push_back({address, width, current_value});
+    entries.insert(std::ranges::upper_bound(entries, address, {}, &Entry::address),
+                   {address, width, current_value});
 
     LOG_DEBUG(Common_Memory,
               "Freezing memory for address={:016X}, width={:02X}, current_value={:016X}", address,
@@ -149,13 +154,13 @@ std::vector<Freezer::Entry> Freezer::GetEntries() const {
 }
 
 Freezer::Entries::iterator Freezer::FindEntry(VAddr address) {
-    return std::find_if(entries.begin(), entries.end(),
-                        [address](const Entry& entry) { return entry.address == address; });
+    const auto iter = std::ranges::lower_bound(entries, address, {}, &Entry::address);
+    return iter != entries.end() && iter->address == address ? iter : entries.end();
 }
 
 Freezer::Entries::const_iterator Freezer::FindEntry(VAddr address) const {
-    return std::find_if(entries.begin(), entries.end(),
-                        [address](const Entry& entry) { return entry.address == address; });
+    const auto iter = std::ranges::lower_bound(entries, address, {}, &Entry::address);
+    return iter != entries.end() && iter->address == address ? iter : entries.end();
 }
 
 void Freezer::FrameCallback(std::chrono::nanoseconds ns_late) {
@@ -166,16 +171,44 @@ void Freezer::FrameCallback(std::chrono::nanoseconds ns_late) {
 
     std::scoped_lock lock{entries_mutex};
 
-    for (const auto& entry : entries) {
-        LOG_DEBUG(Common_Memory,
-                  "Enforcing memory freeze at address={:016X}, value={:016X}, width={:02X}",
-                  entry.address, entry.value, entry.width);
-        MemoryWriteWidth(memory, entry.width, entry.address, entry.value);
+    // Entries are sorted by address, write them one page at a time
+    for (auto iter = entries.cbegin(); iter != entries.cend();) {
+        const VAddr page_address = iter->address & ~Core::Memory::CITRON_PAGEMASK;
+        const auto page_end = std::find_if(iter, entries.cend(), [page_address](const Entry& e) {
+            return (e.address & ~Core::Memory::CITRON_PAGEMASK) != page_address;
+        });
+        WritePage(page_address, {iter, page_end});
+        iter = page_end;
     }
 
     core_timing.ScheduleEvent(memory_freezer_ns - ns_late, event);
 }
 
+void Freezer::WritePage(VAddr page_address, std::span<const Entry> page_entries) {
+    // The page is looked up once and the GPU caches over it are invalidated with a single call,
+    // instead of doing both for every frozen value
+    u8* const page_pointer = memory.GetPointerSilent(page_address);
+    VAddr dirty_begin = ~VAddr{0};
+    VAddr dirty_end = 0;
+    for (const Entry& entry : page_entries) {
+        LOG_TRACE(Common_Memory,
+                  "Enforcing memory freeze at address={:016X}, value={:016X}, width={:02X}",
+                  entry.address, entry.value, entry.width);
+        const VAddr entry_end = entry.address + entry.width;
+        if (!page_pointer || entry_end > page_address + Core::Memory::CITRON_PAGESIZE) {
+            // Unmapped pages and values straddling two pages take the regular path
+            MemoryWriteWidth(memory, entry.width, entry.address, entry.value);
+            continue;
+        }
+        std::memcpy(page_pointer + (entry.address - page_address), &entry.value, entry.width);
+        dirty_begin = std::min(dirty_begin, entry.address);
+        dirty_end = std::max(dirty_end, entry_end);
+    }
+    if (dirty_begin < dirty_end) {
+        memory.StoreDataCache(dirty_begin, dirty_end - dirty_begin);
+    }
+}
+
 void Freezer::FillEntryReads() {
     std::scoped_lock lock{entries_mutex};
 
@@ -8,6 +8,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <vector>
 #include "common/common_types.h"
 
@@ -68,7 +69,8 @@ public:
     // std::nullopt.
     std::optional<Entry> GetEntry(VAddr address) const;
 
-    // Returns all the entries in the freezer, an empty vector means nothing is frozen.
+    // Returns all the entries in the freezer sorted by address, an empty vector means nothing is
+    // frozen.
     std::vector<Entry> GetEntries() const;
 
 private:
@@ -78,12 +80,13 @@ private:
     Entries::const_iterator FindEntry(VAddr address) const;
 
     void FrameCallback(std::chrono::nanoseconds ns_late);
+    void WritePage(VAddr page_address, std::span<const Entry> page_entries);
     void FillEntryReads();
 
     std::atomic_bool active{false};
 
     mutable std::mutex entries_mutex;
-    Entries entries;
+    Entries entries; ///< Sorted by address, so that FrameCallback can batch writes per page
 
     std::shared_ptr<Core::Timing::EventType> event;
     Core::Timing::CoreTiming& core_timing;
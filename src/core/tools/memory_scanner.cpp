@@ -0,0 +1,388 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <thread>
+
+#include "common/assert.h"
+#include "common/literals.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/memory.h"
+#include "core/tools/memory_scanner.h"
+
+namespace Tools {
+namespace {
+using namespace Common::Literals;
+
+constexpr u64 PageSize = Core::Memory::CITRON_PAGESIZE;
+constexpr u64 PageMask = Core::Memory::CITRON_PAGEMASK;
+constexpr size_t ValuesPerWord = 64;
+constexpr u64 PagesPerWorkItem = 256;
+constexpr u64 PatternChunkSize = 1_MiB;
+
+struct WorkItem {
+    size_t region;
+    u64 offset;
+    u64 size;
+};
+
+size_t GetValueSize(MemoryScanner::ValueType type) {
+    switch (type) {
+    case MemoryScanner::ValueType::U8:
+        return 1;
+    case MemoryScanner::ValueType::U16:
+        return 2;
+    case MemoryScanner::ValueType::U32:
+    case MemoryScanner::ValueType::F32:
+        return 4;
+    case MemoryScanner::ValueType::U64:
+    case MemoryScanner::ValueType::F64:
+        return 8;
+    }
+    UNREACHABLE();
+}
+
+/// Splits regions into work items of at most item_size bytes
+template <typename Regions>
+std::vector<WorkItem> SplitWork(const Regions& regions, u64 item_size) {
+    std::vector<WorkItem> items;
+    for (size_t index = 0; index < regions.size(); ++index) {
+        const u64 region_size = regions[index].size;
+        for (u64 offset = 0; offset < region_size; offset += item_size) {
+            items.push_back({index, offset, std::min(item_size, region_size - offset)});
+        }
+    }
+    return items;
+}
+
+/// Runs func on every index in [0, count), spread over the host cores
+template <typename Func>
+void ParallelFor(size_t count, Func&& func) {
+    const size_t num_threads =
+        std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+    std::atomic<size_t> next_index{};
+    const auto worker = [&] {
+        for (size_t index = next_index++; index < count; index = next_index++) {
+            func(index);
+        }
+    };
+    std::vector<std::jthread> threads;
+    for (size_t thread = 1; thread < num_threads; ++thread) {
+        threads.emplace_back(worker);
+    }
+    worker();
+}
+
+template <typename T>
+T LoadValue(const u8* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+/// Clears the candidate bits of a page whose values fail the predicate
+template <typename T, typename Predicate>
+void FilterPage(const u8* current, const u8* previous, u64* words, Predicate&& predicate) {
+    constexpr size_t WordsPerPage = PageSize / sizeof(T) / ValuesPerWord;
+    for (size_t word = 0; word < WordsPerPage; ++word) {
+        if (words[word] == 0) {
+            continue;
+        }
+        const size_t base = word * ValuesPerWord * sizeof(T);
+        u64 matches = 0;
+        // Branchless, so that the compiler vectorizes the comparisons of a whole word
+        for (size_t i = 0; i < ValuesPerWord; ++i) {
+            const size_t offset = base + i * sizeof(T);
+            const bool match =
+                predicate(LoadValue<T>(current + offset), LoadValue<T>(previous + offset));
+            matches |= static_cast<u64>(match) << i;
+        }
+        words[word] &= matches;
+    }
+}
+
+template <typename T>
+void FilterPage(MemoryScanner::Comparison comparison, T target, const u8* current,
+                const u8* previous, u64* words) {
+    using Comparison = MemoryScanner::Comparison;
+    switch (comparison) {
+    case Comparison::Equal:
+        return FilterPage<T>(current, previous, words,
+                             [target](T cur, T) { return cur == target; });
+    case Comparison::NotEqual:
+        return FilterPage<T>(current, previous, words,
+                             [target](T cur, T) { return cur != target; });
+    case Comparison::Changed:
+        return FilterPage<T>(current, previous, words,
+                             [](T cur, T prev) { return cur != prev; });
+    case Comparison::Unchanged:
+        return FilterPage<T>(current, previous, words,
+                             [](T cur, T prev) { return cur == prev; });
+    case Comparison::Increased:
+        return FilterPage<T>(current, previous, words,
+                             [](T cur, T prev) { return cur > prev; });
+    case Comparison::Decreased:
+        return FilterPage<T>(current, previous, words,
+                             [](T cur, T prev) { return cur < prev; });
+    }
+    UNREACHABLE();
+}
+
+bool IsWritable(const Kernel::Svc::MemoryInfo& info) {
+    using Kernel::Svc::MemoryPermission;
+    using Kernel::Svc::MemoryState;
+    if (info.state == MemoryState::Free || info.state == MemoryState::Io ||
+        info.state == MemoryState::Inaccessible) {
+        return false;
+    }
+    return (info.permission & MemoryPermission::ReadWrite) == MemoryPermission::ReadWrite;
+}
+} // Anonymous namespace
+
+MemoryScanner::MemoryScanner(Core::Memory::Memory& memory)
+    : MemoryScanner([&memory](VAddr page_address) -> const u8* {
+          return memory.GetPointerSilent(page_address);
+      }) {}
+
+MemoryScanner::MemoryScanner(PageLookup page_lookup_) : page_lookup{std::move(page_lookup_)} {}
+
+MemoryScanner::~MemoryScanner() = default;
+
+std::vector<MemoryScanner::Region> MemoryScanner::GetWritableRegions(Kernel::KProcess& process) {
+    auto& page_table = process.GetPageTable();
+    std::vector<Region> regions;
+    VAddr cur_addr = 0;
+    while (true) {
+        Kernel::KMemoryInfo mem_info{};
+        Kernel::Svc::PageInfo page_info{};
+        R_ASSERT(page_table.QueryInfo(std::addressof(mem_info), std::addressof(page_info),
+                                      cur_addr));
+        const auto svc_mem_info = mem_info.GetSvcMemoryInfo();
+        if (IsWritable(svc_mem_info)) {
+            // Adjacent writable blocks are scanned as one region
+            if (!regions.empty() &&
+                regions.back().address + regions.back().size == svc_mem_info.base_address) {
+                regions.back().size += svc_mem_info.size;
+            } else {
+                regions.push_back({svc_mem_info.base_address, svc_mem_info.size});
+            }
+        }
+        const VAddr next_address = svc_mem_info.base_address + svc_mem_info.size;
+        if (next_address <= cur_addr) {
+            break;
+        }
+        cur_addr = next_address;
+    }
+    return regions;
+}
+
+void MemoryScanner::NewScan(std::span<const Region> regions, ValueType type) {
+    value_type = type;
+    scan_regions.clear();
+
+    const size_t value_size = GetValueSize(type);
+    const size_t words_per_page = PageSize / value_size / ValuesPerWord;
+    for (const Region& region : regions) {
+        ASSERT(((region.address | region.size) & PageMask) == 0);
+        if (region.size == 0) {
+            continue;
+        }
+        scan_regions.push_back({
+            .address = region.address,
+            .size = region.size,
+            .snapshot = std::vector<u8>(region.size),
+            .candidates = std::vector<u64>(region.size / PageSize * words_per_page),
+        });
+    }
+
+    const auto work = SplitWork(scan_regions, PagesPerWorkItem * PageSize);
+    ParallelFor(work.size(), [&](size_t index) {
+        const WorkItem& item = work[index];
+        ScanRegion& region = scan_regions[item.region];
+        for (u64 offset = item.offset; offset < item.offset + item.size; offset += PageSize) {
+            const u8* const host_pointer = page_lookup(region.address + offset);
+            if (!host_pointer) {
+                continue;
+            }
+            std::memcpy(region.snapshot.data() + offset, host_pointer, PageSize);
+            const auto words = region.candidates.begin() + offset / PageSize * words_per_page;
+            std::fill_n(words, words_per_page, ~u64{0});
+        }
+    });
+}
+
+void MemoryScanner::Filter(Comparison comparison, u64 value) {
+    switch (value_type) {
+    case ValueType::U8:
+        return FilterTyped<u8>(comparison, value);
+    case ValueType::U16:
+        return FilterTyped<u16>(comparison, value);
+    case ValueType::U32:
+        return FilterTyped<u32>(comparison, value);
+    case ValueType::U64:
+        return FilterTyped<u64>(comparison, value);
+    case ValueType::F32:
+        return FilterTyped<f32>(comparison, value);
+    case ValueType::F64:
+        return FilterTyped<f64>(comparison, value);
+    }
+    UNREACHABLE();
+}
+
+template <typename T>
+void MemoryScanner::FilterTyped(Comparison comparison, u64 value) {
+    constexpr size_t WordsPerPage = PageSize / sizeof(T) / ValuesPerWord;
+    T target;
+    std::memcpy(&target, &value, sizeof(T));
+
+    const auto work = SplitWork(scan_regions, PagesPerWorkItem * PageSize);
+    ParallelFor(work.size(), [&](size_t index) {
+        const WorkItem& item = work[index];
+        ScanRegion& region = scan_regions[item.region];
+        std::array<u8, PageSize> current;
+        for (u64 offset = item.offset; offset < item.offset + item.size; offset += PageSize) {
+            u64* const words = region.candidates.data() + offset / PageSize * WordsPerPage;
+            if (std::all_of(words, words + WordsPerPage, [](u64 word) { return word == 0; })) {
+                continue;
+            }
+            const u8* const host_pointer = page_lookup(region.address + offset);
+            if (!host_pointer) {
+                std::fill_n(words, WordsPerPage, 0);
+                continue;
+            }
+            // Compare against a private copy, the guest may be writing to the page meanwhile
+            std::memcpy(current.data(), host_pointer, PageSize);
+            u8* const previous = region.snapshot.data() + offset;
+            FilterPage<T>(comparison, target, current.data(), previous, words);
+            std::memcpy(previous, current.data(), PageSize);
+        }
+    });
+
+    std::erase_if(scan_regions, [](const ScanRegion& region) {
+        return std::ranges::all_of(region.candidates, [](u64 word) { return word == 0; });
+    });
+}
+
+size_t MemoryScanner::GetCandidateCount() const {
+    size_t count = 0;
+    for (const ScanRegion& region : scan_regions) {
+        for (const u64 word : region.candidates) {
+            count += std::popcount(word);
+        }
+    }
+    return count;
+}
+
+std::vector<MemoryScanner::Candidate> MemoryScanner::GetCandidates(size_t max_count) const {
+    const size_t value_size = GetValueSize(value_type);
+    std::vector<Candidate> result;
+    for (const ScanRegion& region : scan_regions) {
+        for (size_t word = 0; word < region.candidates.size(); ++word) {
+            for (u64 bits = region.candidates[word]; bits != 0; bits &= bits - 1) {
+                if (result.size() == max_count) {
+                    return result;
+                }
+                const size_t offset =
+                    (word * ValuesPerWord + std::countr_zero(bits)) * value_size;
+                u64 value = 0;
+                std::memcpy(&value, region.snapshot.data() + offset, value_size);
+                result.push_back({region.address + offset, value});
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<VAddr> MemoryScanner::FindPattern(std::span<const Region> regions,
+                                              std::span<const u8> pattern,
+                                              std::span<const u8> mask, size_t max_results) const {
+    if (pattern.empty() || max_results == 0 || (!mask.empty() && mask.size() != pattern.size())) {
+        return {};
+    }
+    const auto get_mask = [&mask](size_t index) -> u8 { return mask.empty() ? 0xFF : mask[index]; };
+
+    // Candidate positions are found with memchr on the first exactly matched byte, when there is
+    // none every position has to be checked
+    size_t anchor = pattern.size();
+    for (size_t index = 0; index < pattern.size(); ++index) {
+        if (get_mask(index) == 0xFF) {
+            anchor = index;
+            break;
+        }
+    }
+    if (anchor == pattern.size() &&
+        std::ranges::all_of(mask, [](u8 mask_byte) { return mask_byte == 0; })) {
+        return {};
+    }
+    const auto matches = [&](const u8* data) {
+        for (size_t index = 0; index < pattern.size(); ++index) {
+            const u8 mask_byte = get_mask(index);
+            if ((data[index] & mask_byte) != (pattern[index] & mask_byte)) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const auto work = SplitWork(regions, PatternChunkSize);
+    std::vector<std::vector<VAddr>> item_results(work.size());
+    ParallelFor(work.size(), [&](size_t index) {
+        const WorkItem& item = work[index];
+        const Region& region = regions[item.region];
+        // Chunks overlap by the pattern size so that matches crossing into the next chunk are
+        // found, only matches starting inside the chunk are reported
+        const u64 copy_size = std::min(item.size + pattern.size() - 1, region.size - item.offset);
+        if (copy_size < pattern.size()) {
+            return;
+        }
+        std::vector<u8> buffer(copy_size);
+        std::vector<bool> page_mapped((copy_size + PageMask) / PageSize);
+        for (u64 offset = 0; offset < copy_size; offset += PageSize) {
+            const u8* const host_pointer = page_lookup(region.address + item.offset + offset);
+            page_mapped[offset / PageSize] = host_pointer != nullptr;
+            if (host_pointer) {
+                std::memcpy(buffer.data() + offset, host_pointer,
+                            std::min(PageSize, copy_size - offset));
+            }
+        }
+
+        auto& results = item_results[index];
+        const size_t last_start = std::min<u64>(item.size, copy_size - pattern.size() + 1);
+        size_t start = 0;
+        while (start < last_start && results.size() < max_results) {
+            if (anchor != pattern.size()) {
+                const void* const found = std::memchr(buffer.data() + start + anchor,
+                                                      pattern[anchor], last_start - start);
+                if (!found) {
+                    break;
+                }
+                start = static_cast<const u8*>(found) - buffer.data() - anchor;
+            }
+            const size_t first_page = start / PageSize;
+            const size_t last_page = (start + pattern.size() - 1) / PageSize;
+            const bool mapped = std::all_of(page_mapped.begin() + first_page,
+                                            page_mapped.begin() + last_page + 1,
+                                            [](bool is_mapped) { return is_mapped; });
+            if (mapped && matches(buffer.data() + start)) {
+                results.push_back(region.address + item.offset + start);
+            }
+            ++start;
+        }
+    });
+
+    std::vector<VAddr> result;
+    for (const auto& results : item_results) {
+        result.insert(result.end(), results.begin(), results.end());
+    }
+    std::ranges::sort(result);
+    if (result.size() > max_results) {
+        result.resize(max_results);
+    }
+    return result;
+}
+
+} // namespace Tools
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace Kernel {
+class KProcess;
+}
+
+namespace Tools {
+
+/**
+ * Searches guest memory for values and byte patterns, the way cheat searchers narrow down the
+ * address of a game variable.
+ *
+ * A value scan starts with NewScan, which snapshots the scanned regions and makes every naturally
+ * aligned value a candidate. Each Filter call then drops the candidates that fail a comparison,
+ * either against a constant or against their value at the previous scan. Candidates are kept as
+ * one bit per value and only pages that still have candidates are read again, so scans get
+ * cheaper as they narrow down.
+ *
+ * Guest memory is read in place while emulation keeps running. A value the guest writes during a
+ * scan is seen either before or after the write, each page is copied once per scan so a single
+ * scan never sees both.
+ */
+class MemoryScanner {
+public:
+    enum class ValueType : u32 {
+        U8,
+        U16,
+        U32,
+        U64,
+        F32,
+        F64,
+    };
+
+    enum class Comparison : u32 {
+        Equal,     ///< Equal to the given value
+        NotEqual,  ///< Not equal to the given value
+        Changed,   ///< Different from the previous scan
+        Unchanged, ///< Same as the previous scan
+        Increased, ///< Greater than at the previous scan
+        Decreased, ///< Less than at the previous scan
+    };
+
+    struct Region {
+        VAddr address;
+        u64 size;
+    };
+
+    struct Candidate {
+        VAddr address;
+        u64 value; ///< Raw bits of the value at the last scan
+    };
+
+    /// Returns the host pointer backing a guest page, or nullptr if the page is not mapped
+    using PageLookup = std::function<const u8*(VAddr page_address)>;
+
+    explicit MemoryScanner(Core::Memory::Memory& memory);
+    explicit MemoryScanner(PageLookup page_lookup);
+    ~MemoryScanner();
+
+    // Returns the mapped regions of a process that the application can write to.
+    static std::vector<Region> GetWritableRegions(Kernel::KProcess& process);
+
+    // Starts a new value scan over the given page aligned regions, every aligned value of the
+    // given type is a candidate.
+    void NewScan(std::span<const Region> regions, ValueType type);
+
+    // Drops the candidates that do not satisfy the comparison. Value holds the raw bits of the
+    // value to compare against, it is ignored by comparisons against the previous scan.
+    void Filter(Comparison comparison, u64 value = 0);
+
+    // Returns the number of remaining candidates.
+    size_t GetCandidateCount() const;
+
+    // Returns up to max_count of the remaining candidates, sorted by address.
+    std::vector<Candidate> GetCandidates(size_t max_count) const;
+
+    // Returns the addresses in the given page aligned regions where a byte pattern occurs, sorted
+    // and limited to max_results.
+    // Pattern bytes with a zero mask byte match anything, an empty mask matches every byte
+    // exactly. A pattern made only of wildcards matches nothing.
+    std::vector<VAddr> FindPattern(std::span<const Region> regions, std::span<const u8> pattern,
+                                   std::span<const u8> mask, size_t max_results) const;
+
+private:
+    struct ScanRegion {
+        VAddr address;
+        u64 size;
+        std::vector<u8> snapshot;    ///< Values at the last scan
+        std::vector<u64> candidates; ///< One bit per value, a page always spans whole words
+    };
+
+    template <typename T>
+    void FilterTyped(Comparison comparison, u64 value);
+
+    PageLookup page_lookup;
+    ValueType value_type{};
+    std::vector<ScanRegion> scan_regions;
+};
+
+} // namespace Tools
@@ -396,11 +396,33 @@ std::string_view GetTessSpacing(TessSpacing spacing) {
     }
     throw InvalidArgument("Invalid tessellation spacing {}", spacing);
 }
+// Rough average of GLASM characters emitted per IR instruction
+constexpr size_t CHARS_PER_INST = 28;
+
+size_t EstimateCodeSize(const IR::Program& program) {
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    // Stages with varying inputs and outputs emit extra prologue and epilogue code
+    const size_t stage_overhead{[&] {
+        switch (program.stage) {
+        case Stage::Compute:
+            return size_t{256};
+        case Stage::Fragment:
+            return size_t{1024};
+        default:
+            return size_t{2048};
+        }
+    }()};
+    return num_insts * CHARS_PER_INST + stage_overhead;
+}
 } // Anonymous namespace
 
 std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, IR::Program& program,
                       Bindings& bindings) {
     EmitContext ctx{program, bindings, profile, runtime_info};
+    ctx.code.reserve(EstimateCodeSize(program));
     Precolor(program);
     EmitCode(ctx, program);
     std::string header{StageHeader(program.stage)};
@@ -492,9 +514,12 @@ std::string EmitGLASM(const Profile& profile, const RuntimeInfo& runtime_info, I
     if (ctx.uses_y_direction) {
         header += "PARAM y_direction[1]={state.material.front.ambient};";
     }
-    ctx.code.insert(0, header);
-    ctx.code += "END";
-    return ctx.code;
+    std::string shader;
+    shader.reserve(header.size() + ctx.code.size() + 3);
+    shader += header;
+    shader.append(ctx.code.data(), ctx.code.size());
+    shader += "END";
+    return shader;
 }
 
 } // namespace Shader::Backend::GLASM
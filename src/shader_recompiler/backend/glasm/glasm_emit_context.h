@@ -35,29 +35,30 @@ public:
                          const RuntimeInfo& runtime_info_);
 
     template <typename... Args>
-    void Add(const char* format_str, IR::Inst& inst, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), reg_alloc.Define(inst),
-                            std::forward<Args>(args)...);
+    void Add(fmt::format_string<Register, Args...> format_str, IR::Inst& inst, Args&&... args) {
+        fmt::format_to(fmt::appender(code), format_str, reg_alloc.Define(inst),
+                       std::forward<Args>(args)...);
         // TODO: Remove this
-        code += '\n';
+        code.push_back('\n');
     }
 
     template <typename... Args>
-    void LongAdd(const char* format_str, IR::Inst& inst, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), reg_alloc.LongDefine(inst),
-                            std::forward<Args>(args)...);
+    void LongAdd(fmt::format_string<Register, Args...> format_str, IR::Inst& inst,
+                 Args&&... args) {
+        fmt::format_to(fmt::appender(code), format_str, reg_alloc.LongDefine(inst),
+                       std::forward<Args>(args)...);
         // TODO: Remove this
-        code += '\n';
+        code.push_back('\n');
     }
 
     template <typename... Args>
-    void Add(const char* format_str, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), std::forward<Args>(args)...);
+    void Add(fmt::format_string<Args...> format_str, Args&&... args) {
+        fmt::format_to(fmt::appender(code), format_str, std::forward<Args>(args)...);
         // TODO: Remove this
-        code += '\n';
+        code.push_back('\n');
     }
 
-    std::string code;
+    fmt::memory_buffer code;
     RegAlloc reg_alloc{};
     const Info& info;
     const Profile& profile;
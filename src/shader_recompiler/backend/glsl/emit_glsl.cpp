@@ -212,11 +212,33 @@ void DefineVariables(const EmitContext& ctx, std::string& header) {
         header += fmt::format("int loop{}=0x2000;", i);
     }
 }
+// Rough average of GLSL characters emitted per IR instruction
+constexpr size_t CHARS_PER_INST = 40;
+
+size_t EstimateCodeSize(const IR::Program& program) {
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += block->size();
+    }
+    // Stages with varying inputs and outputs emit extra prologue and epilogue code
+    const size_t stage_overhead{[&] {
+        switch (program.stage) {
+        case Stage::Compute:
+            return size_t{256};
+        case Stage::Fragment:
+            return size_t{1024};
+        default:
+            return size_t{2048};
+        }
+    }()};
+    return num_insts * CHARS_PER_INST + stage_overhead;
+}
 } // Anonymous namespace
 
 std::string EmitGLSL(const Profile& profile, const RuntimeInfo& runtime_info, IR::Program& program,
                      Bindings& bindings) {
     EmitContext ctx{program, bindings, profile, runtime_info};
+    ctx.code.reserve(EstimateCodeSize(program));
     Precolor(program);
     EmitCode(ctx, program);
     const std::string version{fmt::format("#version 460{}\n", GlslVersionSpecifier(ctx))};
@@ -244,9 +266,12 @@ std::string EmitGLSL(const Profile& profile, const RuntimeInfo& runtime_info, IR
         ctx.header += "bool shfl_in_bounds;";
         ctx.header += "uint shfl_result;";
     }
-    ctx.code.insert(0, ctx.header);
-    ctx.code += '}';
-    return ctx.code;
+    std::string shader;
+    shader.reserve(ctx.header.size() + ctx.code.size() + 1);
+    shader += ctx.header;
+    shader.append(ctx.code.data(), ctx.code.size());
+    shader += '}';
+    return shader;
 }
 
 } // namespace Shader::Backend::GLSL
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -46,97 +48,115 @@ public:
                          const RuntimeInfo& runtime_info_);
 
     template <GlslVarType type, typename... Args>
-    void Add(const char* format_str, IR::Inst& inst, Args&&... args) {
-        const auto var_def{var_alloc.AddDefine(inst, type)};
+    void Add(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+             Args&&... args) {
+        const std::string var_def{var_alloc.AddDefine(inst, type)};
+        const std::string_view var_def_view{var_def};
+        const size_t start{code.size()};
+        fmt::vformat_to(fmt::appender(code), fmt::string_view{format_str},
+                        fmt::make_format_args(var_def_view, args...));
         if (var_def.empty()) {
-            // skip assignment.
-            code += fmt::format(fmt::runtime(format_str + 3), std::forward<Args>(args)...);
-        } else {
-            code += fmt::format(fmt::runtime(format_str), var_def, std::forward<Args>(args)...);
+            // Skip the assignment, every format string starts with "{}="
+            std::copy(code.data() + start + 1, code.data() + code.size(), code.data() + start);
+            code.resize(code.size() - 1);
         }
         // TODO: Remove this
-        code += '\n';
+        code.push_back('\n');
     }
 
     template <typename... Args>
-    void AddU1(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U1>(format_str, inst, args...);
+    void AddU1(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+               Args&&... args) {
+        Add<GlslVarType::U1>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF16x2(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F16x2>(format_str, inst, args...);
+    void AddF16x2(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::F16x2>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddU32(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U32>(format_str, inst, args...);
+    void AddU32(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                Args&&... args) {
+        Add<GlslVarType::U32>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF32(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F32>(format_str, inst, args...);
+    void AddF32(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                Args&&... args) {
+        Add<GlslVarType::F32>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddU64(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U64>(format_str, inst, args...);
+    void AddU64(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                Args&&... args) {
+        Add<GlslVarType::U64>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF64(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F64>(format_str, inst, args...);
+    void AddF64(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                Args&&... args) {
+        Add<GlslVarType::F64>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddU32x2(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U32x2>(format_str, inst, args...);
+    void AddU32x2(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::U32x2>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF32x2(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F32x2>(format_str, inst, args...);
+    void AddF32x2(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::F32x2>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddU32x3(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U32x3>(format_str, inst, args...);
+    void AddU32x3(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::U32x3>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF32x3(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F32x3>(format_str, inst, args...);
+    void AddF32x3(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::F32x3>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddU32x4(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::U32x4>(format_str, inst, args...);
+    void AddU32x4(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::U32x4>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddF32x4(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::F32x4>(format_str, inst, args...);
+    void AddF32x4(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                  Args&&... args) {
+        Add<GlslVarType::F32x4>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddPrecF32(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::PrecF32>(format_str, inst, args...);
+    void AddPrecF32(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                    Args&&... args) {
+        Add<GlslVarType::PrecF32>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void AddPrecF64(const char* format_str, IR::Inst& inst, Args&&... args) {
-        Add<GlslVarType::PrecF64>(format_str, inst, args...);
+    void AddPrecF64(fmt::format_string<std::string_view, Args...> format_str, IR::Inst& inst,
+                    Args&&... args) {
+        Add<GlslVarType::PrecF64>(format_str, inst, std::forward<Args>(args)...);
     }
 
     template <typename... Args>
-    void Add(const char* format_str, Args&&... args) {
-        code += fmt::format(fmt::runtime(format_str), std::forward<Args>(args)...);
+    void Add(fmt::format_string<Args...> format_str, Args&&... args) {
+        fmt::format_to(fmt::appender(code), format_str, std::forward<Args>(args)...);
         // TODO: Remove this
-        code += '\n';
+        code.push_back('\n');
     }
 
     std::string header;
-    std::string code;
+    fmt::memory_buffer code;
     VarAlloc var_alloc;
     const Info& info;
     const Profile& profile;
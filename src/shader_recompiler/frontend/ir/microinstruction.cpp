@@ -246,6 +246,270 @@ bool Inst::IsPseudoInstruction() const noexcept {
     }
 }
 
+bool Inst::IsPure() const noexcept {
+    switch (op) {
+    case Opcode::GetCbufU8:
+    case Opcode::GetCbufS8:
+    case Opcode::GetCbufU16:
+    case Opcode::GetCbufS16:
+    case Opcode::GetCbufU32:
+    case Opcode::GetCbufF32:
+    case Opcode::GetCbufU32x2:
+    case Opcode::WorkgroupId:
+    case Opcode::LocalInvocationId:
+    case Opcode::InvocationId:
+    case Opcode::InvocationInfo:
+    case Opcode::SampleId:
+    case Opcode::YDirection:
+    case Opcode::ResolutionDownFactor:
+    case Opcode::RenderArea:
+    case Opcode::CompositeConstructU32x2:
+    case Opcode::CompositeConstructU32x3:
+    case Opcode::CompositeConstructU32x4:
+    case Opcode::CompositeExtractU32x2:
+    case Opcode::CompositeExtractU32x3:
+    case Opcode::CompositeExtractU32x4:
+    case Opcode::CompositeInsertU32x2:
+    case Opcode::CompositeInsertU32x3:
+    case Opcode::CompositeInsertU32x4:
+    case Opcode::CompositeConstructF16x2:
+    case Opcode::CompositeConstructF16x3:
+    case Opcode::CompositeConstructF16x4:
+    case Opcode::CompositeExtractF16x2:
+    case Opcode::CompositeExtractF16x3:
+    case Opcode::CompositeExtractF16x4:
+    case Opcode::CompositeInsertF16x2:
+    case Opcode::CompositeInsertF16x3:
+    case Opcode::CompositeInsertF16x4:
+    case Opcode::CompositeConstructF32x2:
+    case Opcode::CompositeConstructF32x3:
+    case Opcode::CompositeConstructF32x4:
+    case Opcode::CompositeExtractF32x2:
+    case Opcode::CompositeExtractF32x3:
+    case Opcode::CompositeExtractF32x4:
+    case Opcode::CompositeInsertF32x2:
+    case Opcode::CompositeInsertF32x3:
+    case Opcode::CompositeInsertF32x4:
+    case Opcode::CompositeConstructF64x2:
+    case Opcode::CompositeConstructF64x3:
+    case Opcode::CompositeConstructF64x4:
+    case Opcode::CompositeExtractF64x2:
+    case Opcode::CompositeExtractF64x3:
+    case Opcode::CompositeExtractF64x4:
+    case Opcode::CompositeInsertF64x2:
+    case Opcode::CompositeInsertF64x3:
+    case Opcode::CompositeInsertF64x4:
+    case Opcode::SelectU1:
+    case Opcode::SelectU8:
+    case Opcode::SelectU16:
+    case Opcode::SelectU32:
+    case Opcode::SelectU64:
+    case Opcode::SelectF16:
+    case Opcode::SelectF32:
+    case Opcode::SelectF64:
+    case Opcode::BitCastU16F16:
+    case Opcode::BitCastU32F32:
+    case Opcode::BitCastU64F64:
+    case Opcode::BitCastF16U16:
+    case Opcode::BitCastF32U32:
+    case Opcode::BitCastF64U64:
+    case Opcode::PackUint2x32:
+    case Opcode::UnpackUint2x32:
+    case Opcode::PackFloat2x16:
+    case Opcode::UnpackFloat2x16:
+    case Opcode::PackHalf2x16:
+    case Opcode::UnpackHalf2x16:
+    case Opcode::PackDouble2x32:
+    case Opcode::UnpackDouble2x32:
+    case Opcode::FPAbs16:
+    case Opcode::FPAbs32:
+    case Opcode::FPAbs64:
+    case Opcode::FPAdd16:
+    case Opcode::FPAdd32:
+    case Opcode::FPAdd64:
+    case Opcode::FPFma16:
+    case Opcode::FPFma32:
+    case Opcode::FPFma64:
+    case Opcode::FPMax32:
+    case Opcode::FPMax64:
+    case Opcode::FPMin32:
+    case Opcode::FPMin64:
+    case Opcode::FPMul16:
+    case Opcode::FPMul32:
+    case Opcode::FPMul64:
+    case Opcode::FPNeg16:
+    case Opcode::FPNeg32:
+    case Opcode::FPNeg64:
+    case Opcode::FPRecip32:
+    case Opcode::FPRecip64:
+    case Opcode::FPRecipSqrt32:
+    case Opcode::FPRecipSqrt64:
+    case Opcode::FPSqrt:
+    case Opcode::FPSin:
+    case Opcode::FPExp2:
+    case Opcode::FPCos:
+    case Opcode::FPLog2:
+    case Opcode::FPSaturate16:
+    case Opcode::FPSaturate32:
+    case Opcode::FPSaturate64:
+    case Opcode::FPClamp16:
+    case Opcode::FPClamp32:
+    case Opcode::FPClamp64:
+    case Opcode::FPRoundEven16:
+    case Opcode::FPRoundEven32:
+    case Opcode::FPRoundEven64:
+    case Opcode::FPFloor16:
+    case Opcode::FPFloor32:
+    case Opcode::FPFloor64:
+    case Opcode::FPCeil16:
+    case Opcode::FPCeil32:
+    case Opcode::FPCeil64:
+    case Opcode::FPTrunc16:
+    case Opcode::FPTrunc32:
+    case Opcode::FPTrunc64:
+    case Opcode::FPOrdEqual16:
+    case Opcode::FPOrdEqual32:
+    case Opcode::FPOrdEqual64:
+    case Opcode::FPUnordEqual16:
+    case Opcode::FPUnordEqual32:
+    case Opcode::FPUnordEqual64:
+    case Opcode::FPOrdNotEqual16:
+    case Opcode::FPOrdNotEqual32:
+    case Opcode::FPOrdNotEqual64:
+    case Opcode::FPUnordNotEqual16:
+    case Opcode::FPUnordNotEqual32:
+    case Opcode::FPUnordNotEqual64:
+    case Opcode::FPOrdLessThan16:
+    case Opcode::FPOrdLessThan32:
+    case Opcode::FPOrdLessThan64:
+    case Opcode::FPUnordLessThan16:
+    case Opcode::FPUnordLessThan32:
+    case Opcode::FPUnordLessThan64:
+    case Opcode::FPOrdGreaterThan16:
+    case Opcode::FPOrdGreaterThan32:
+    case Opcode::FPOrdGreaterThan64:
+    case Opcode::FPUnordGreaterThan16:
+    case Opcode::FPUnordGreaterThan32:
+    case Opcode::FPUnordGreaterThan64:
+    case Opcode::FPOrdLessThanEqual16:
+    case Opcode::FPOrdLessThanEqual32:
+    case Opcode::FPOrdLessThanEqual64:
+    case Opcode::FPUnordLessThanEqual16:
+    case Opcode::FPUnordLessThanEqual32:
+    case Opcode::FPUnordLessThanEqual64:
+    case Opcode::FPOrdGreaterThanEqual16:
+    case Opcode::FPOrdGreaterThanEqual32:
+    case Opcode::FPOrdGreaterThanEqual64:
+    case Opcode::FPUnordGreaterThanEqual16:
+    case Opcode::FPUnordGreaterThanEqual32:
+    case Opcode::FPUnordGreaterThanEqual64:
+    case Opcode::FPIsNan16:
+    case Opcode::FPIsNan32:
+    case Opcode::FPIsNan64:
+    case Opcode::IAdd32:
+    case Opcode::IAdd64:
+    case Opcode::ISub32:
+    case Opcode::ISub64:
+    case Opcode::IMul32:
+    case Opcode::SDiv32:
+    case Opcode::UDiv32:
+    case Opcode::INeg32:
+    case Opcode::INeg64:
+    case Opcode::IAbs32:
+    case Opcode::ShiftLeftLogical32:
+    case Opcode::ShiftLeftLogical64:
+    case Opcode::ShiftRightLogical32:
+    case Opcode::ShiftRightLogical64:
+    case Opcode::ShiftRightArithmetic32:
+    case Opcode::ShiftRightArithmetic64:
+    case Opcode::BitwiseAnd32:
+    case Opcode::BitwiseOr32:
+    case Opcode::BitwiseXor32:
+    case Opcode::BitFieldInsert:
+    case Opcode::BitFieldSExtract:
+    case Opcode::BitFieldUExtract:
+    case Opcode::BitReverse32:
+    case Opcode::BitCount32:
+    case Opcode::BitwiseNot32:
+    case Opcode::FindSMsb32:
+    case Opcode::FindUMsb32:
+    case Opcode::SMin32:
+    case Opcode::UMin32:
+    case Opcode::SMax32:
+    case Opcode::UMax32:
+    case Opcode::SClamp32:
+    case Opcode::UClamp32:
+    case Opcode::SLessThan:
+    case Opcode::ULessThan:
+    case Opcode::IEqual:
+    case Opcode::SLessThanEqual:
+    case Opcode::ULessThanEqual:
+    case Opcode::SGreaterThan:
+    case Opcode::UGreaterThan:
+    case Opcode::INotEqual:
+    case Opcode::SGreaterThanEqual:
+    case Opcode::UGreaterThanEqual:
+    case Opcode::LogicalOr:
+    case Opcode::LogicalAnd:
+    case Opcode::LogicalXor:
+    case Opcode::LogicalNot:
+    case Opcode::ConvertS16F16:
+    case Opcode::ConvertS16F32:
+    case Opcode::ConvertS16F64:
+    case Opcode::ConvertS32F16:
+    case Opcode::ConvertS32F32:
+    case Opcode::ConvertS32F64:
+    case Opcode::ConvertS64F16:
+    case Opcode::ConvertS64F32:
+    case Opcode::ConvertS64F64:
+    case Opcode::ConvertU16F16:
+    case Opcode::ConvertU16F32:
+    case Opcode::ConvertU16F64:
+    case Opcode::ConvertU32F16:
+    case Opcode::ConvertU32F32:
+    case Opcode::ConvertU32F64:
+    case Opcode::ConvertU64F16:
+    case Opcode::ConvertU64F32:
+    case Opcode::ConvertU64F64:
+    case Opcode::ConvertU64U32:
+    case Opcode::ConvertU32U64:
+    case Opcode::ConvertF16F32:
+    case Opcode::ConvertF32F16:
+    case Opcode::ConvertF32F64:
+    case Opcode::ConvertF64F32:
+    case Opcode::ConvertF16S8:
+    case Opcode::ConvertF16S16:
+    case Opcode::ConvertF16S32:
+    case Opcode::ConvertF16S64:
+    case Opcode::ConvertF16U8:
+    case Opcode::ConvertF16U16:
+    case Opcode::ConvertF16U32:
+    case Opcode::ConvertF16U64:
+    case Opcode::ConvertF32S8:
+    case Opcode::ConvertF32S16:
+    case Opcode::ConvertF32S32:
+    case Opcode::ConvertF32S64:
+    case Opcode::ConvertF32U8:
+    case Opcode::ConvertF32U16:
+    case Opcode::ConvertF32U32:
+    case Opcode::ConvertF32U64:
+    case Opcode::ConvertF64S8:
+    case Opcode::ConvertF64S16:
+    case Opcode::ConvertF64S32:
+    case Opcode::ConvertF64S64:
+    case Opcode::ConvertF64U8:
+    case Opcode::ConvertF64U16:
+    case Opcode::ConvertF64U32:
+    case Opcode::ConvertF64U64:
+    case Opcode::IsTextureScaled:
+    case Opcode::IsImageScaled:
+    case Opcode::LaneId:
+        return true;
+    default:
+        return false;
+    }
+}
+
 bool Inst::AreAllArgsImmediates() const {
     if (op == Opcode::Phi) {
         throw LogicError("Testing for all arguments are immediates on phi instruction");
@@ -148,6 +148,11 @@ public:
     /// Pseudo-instructions depend on their parent instructions for their semantics.
     [[nodiscard]] bool IsPseudoInstruction() const noexcept;
 
+    /// Determines whether this instruction only computes a value from its arguments and flags.
+    /// Two pure instructions with the same opcode, flags and arguments always compute the same
+    /// value, regardless of where they are executed.
+    [[nodiscard]] bool IsPure() const noexcept;
+
     /// Determines if all arguments of this instruction are immediates.
     [[nodiscard]] bool AreAllArgsImmediates() const;
 
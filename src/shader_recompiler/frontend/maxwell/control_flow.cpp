@@ -12,8 +12,6 @@
 #include "common/polyfill_ranges.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
-#include "shader_recompiler/frontend/maxwell/decode.h"
-#include "shader_recompiler/frontend/maxwell/indirect_branch_table_track.h"
 #include "shader_recompiler/frontend/maxwell/location.h"
 
 namespace Shader::Maxwell::Flow {
@@ -186,8 +184,8 @@ Function::Function(ObjectPool<Block>& block_pool, Location start_address)
 
 CFG::CFG(Environment& env_, ObjectPool<Block>& block_pool_, Location start_address,
          bool exits_to_dispatcher_)
-    : env{env_}, block_pool{block_pool_}, program_start{start_address}, exits_to_dispatcher{
-                                                                            exits_to_dispatcher_} {
+    : env{env_}, instruction_cache{env_, start_address}, block_pool{block_pool_},
+      program_start{start_address}, exits_to_dispatcher{exits_to_dispatcher_} {
     if (exits_to_dispatcher) {
         dispatch_block = block_pool.Create(Block{});
         dispatch_block->begin = {};
@@ -253,12 +251,13 @@ void CFG::AnalyzeLabel(FunctionId function_id, Label& label) {
 bool CFG::InspectVisitedBlocks(FunctionId function_id, const Label& label) {
     const Location pc{label.address};
     Function& function{functions[function_id]};
-    const auto it{
-        std::ranges::find_if(function.blocks, [pc](auto& block) { return block.Contains(pc); })};
-    if (it == function.blocks.end()) {
+    // Blocks don't overlap, so only the last block starting before pc can contain it
+    auto it{function.blocks.upper_bound(pc, Compare{})};
+    if (it == function.blocks.begin() || !std::prev(it)->Contains(pc)) {
         // Address has not been visited
         return false;
     }
+    --it;
     Block* const visited_block{&*it};
     if (visited_block->begin == pc) {
         throw LogicError("Dangling block");
@@ -270,8 +269,9 @@ bool CFG::InspectVisitedBlocks(FunctionId function_id, const Label& label) {
 }
 
 CFG::AnalysisState CFG::AnalyzeInst(Block* block, FunctionId function_id, Location pc) {
-    const Instruction inst{env.ReadInstruction(pc.Offset())};
-    const Opcode opcode{Decode(inst.raw)};
+    const DecodedInstruction decoded{instruction_cache.Get(pc)};
+    const Instruction inst{decoded.raw};
+    const Opcode opcode{decoded.opcode};
     switch (opcode) {
     case Opcode::BRA:
     case Opcode::JMP:
@@ -428,9 +428,12 @@ void CFG::AnalyzeBRA(Block* block, FunctionId function_id, Location pc, Instruct
 
 CFG::AnalysisState CFG::AnalyzeBRX(Block* block, Location pc, Instruction inst, bool is_absolute,
                                    FunctionId function_id) {
-    const std::optional brx_table{TrackIndirectBranchTable(env, pc, program_start)};
+    auto [table_it, is_new]{indirect_branch_tables.try_emplace(pc.Offset())};
+    if (is_new) {
+        table_it->second = TrackIndirectBranchTable(instruction_cache, pc, program_start);
+    }
+    const std::optional<IndirectBranchTableInfo>& brx_table{table_it->second};
     if (!brx_table) {
-        TrackIndirectBranchTable(env, pc, program_start);
         throw NotImplementedException("Failed to track indirect branch");
     }
     const IR::FlowTest flow_test{inst.branch.flow_test};
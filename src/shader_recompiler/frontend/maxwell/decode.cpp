@@ -4,7 +4,6 @@
 #include <algorithm>
 #include <array>
 #include <bit>
-#include <memory>
 
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
@@ -84,65 +83,119 @@ constexpr size_t ToFastLookupIndex(u64 value) {
     return static_cast<size_t>(value >> MASK_SHIFT);
 }
 
-constexpr size_t FastLookupSize() {
-    size_t max_width{};
-    for (const InstEncoding& encoding : ENCODINGS) {
-        max_width = std::max(max_width, ToFastLookupIndex(encoding.mask_value.mask));
+// The decode table is split in two levels. The first level is indexed by the highest bits of
+// the instruction and either resolves the opcode directly, or points to a second level table
+// indexed by the remaining bits when encodings sharing that prefix differ in the lower bits.
+// Entries are resolved at compile time, so decoding never searches through encodings.
+constexpr int FIRST_LEVEL_BITS{std::min(WIDEST_LEFT_BITS, 9)};
+constexpr int SECOND_LEVEL_BITS{WIDEST_LEFT_BITS - FIRST_LEVEL_BITS};
+constexpr size_t FIRST_LEVEL_SIZE{size_t{1} << FIRST_LEVEL_BITS};
+constexpr size_t SECOND_LEVEL_SIZE{size_t{1} << SECOND_LEVEL_BITS};
+constexpr size_t SECOND_LEVEL_MASK{SECOND_LEVEL_SIZE - 1};
+
+constexpr u16 INVALID_ENTRY{0x7fff};
+constexpr u16 SECOND_LEVEL_FLAG{0x8000};
+static_assert(ENCODINGS.size() < INVALID_ENTRY);
+
+/// Calls func for every value that matches the given bits once the free bits are filled in
+template <typename Func>
+constexpr void ForEachMatch(size_t mask, size_t value, size_t num_bits, Func&& func) {
+    const size_t free_bits{~mask & ((size_t{1} << num_bits) - 1)};
+    size_t bits{free_bits};
+    while (true) {
+        func(value | bits);
+        if (bits == 0) {
+            break;
+        }
+        bits = (bits - 1) & free_bits;
     }
-    return max_width + 1;
 }
-constexpr size_t FAST_LOOKUP_SIZE{FastLookupSize()};
-
-struct InstInfo {
-    [[nodiscard]] u64 Mask() const noexcept {
-        return static_cast<u64>(high_mask) << MASK_SHIFT;
-    }
 
-    [[nodiscard]] u64 Value() const noexcept {
-        return static_cast<u64>(high_value) << MASK_SHIFT;
-    }
+enum class FirstLevelState : u8 {
+    Unresolved,
+    Direct,
+    SecondLevel,
+};
 
-    u16 high_mask;
-    u16 high_value;
-    Opcode opcode;
+struct FirstLevelInfo {
+    std::array<FirstLevelState, FIRST_LEVEL_SIZE> states{};
+    std::array<u16, FIRST_LEVEL_SIZE> entries{};
+    size_t num_second_level_tables{};
 };
 
-constexpr auto MakeFastLookupTableIndex(size_t index) {
-    std::array<InstInfo, 2> encodings{};
-    size_t element{};
-    for (const auto& encoding : ENCODINGS) {
+constexpr FirstLevelInfo MakeFirstLevel() {
+    FirstLevelInfo info{};
+    info.entries.fill(INVALID_ENTRY);
+    // Encodings are visited from highest to lowest priority, the first one that matches a prefix
+    // regardless of the lower bits resolves it
+    for (const InstEncoding& encoding : ENCODINGS) {
         const size_t mask{ToFastLookupIndex(encoding.mask_value.mask)};
         const size_t value{ToFastLookupIndex(encoding.mask_value.value)};
-        if ((index & mask) == value) {
-            encodings.at(element) = InstInfo{
-                .high_mask = static_cast<u16>(encoding.mask_value.mask >> MASK_SHIFT),
-                .high_value = static_cast<u16>(encoding.mask_value.value >> MASK_SHIFT),
-                .opcode = encoding.opcode,
-            };
-            ++element;
-        }
+        const bool uses_low_bits{(mask & SECOND_LEVEL_MASK) != 0};
+        ForEachMatch(mask >> SECOND_LEVEL_BITS, value >> SECOND_LEVEL_BITS, FIRST_LEVEL_BITS,
+                     [&](size_t prefix) {
+                         if (info.states[prefix] != FirstLevelState::Unresolved) {
+                             return;
+                         }
+                         if (uses_low_bits) {
+                             info.states[prefix] = FirstLevelState::SecondLevel;
+                             info.entries[prefix] = static_cast<u16>(
+                                 SECOND_LEVEL_FLAG | info.num_second_level_tables);
+                             ++info.num_second_level_tables;
+                         } else {
+                             info.states[prefix] = FirstLevelState::Direct;
+                             info.entries[prefix] = static_cast<u16>(encoding.opcode);
+                         }
+                     });
     }
-    return encodings;
+    return info;
 }
+constexpr FirstLevelInfo FIRST_LEVEL{MakeFirstLevel()};
+
+struct DecodeTable {
+    std::array<u16, FIRST_LEVEL_SIZE> first_level;
+    std::array<std::array<u16, SECOND_LEVEL_SIZE>, FIRST_LEVEL.num_second_level_tables>
+        second_level;
+};
 
-/*constexpr*/ auto MakeFastLookupTable() {
-    auto encodings{std::make_unique<std::array<std::array<InstInfo, 2>, FAST_LOOKUP_SIZE>>()};
-    for (size_t index = 0; index < FAST_LOOKUP_SIZE; ++index) {
-        (*encodings)[index] = MakeFastLookupTableIndex(index);
+constexpr DecodeTable MakeDecodeTable() {
+    DecodeTable table{};
+    table.first_level = FIRST_LEVEL.entries;
+    for (auto& second_level : table.second_level) {
+        second_level.fill(INVALID_ENTRY);
     }
-    return encodings;
+    // Lower priority encodings are written first so higher priority ones overwrite them
+    for (auto it = ENCODINGS.rbegin(); it != ENCODINGS.rend(); ++it) {
+        const size_t mask{ToFastLookupIndex(it->mask_value.mask)};
+        const size_t value{ToFastLookupIndex(it->mask_value.value)};
+        ForEachMatch(mask >> SECOND_LEVEL_BITS, value >> SECOND_LEVEL_BITS, FIRST_LEVEL_BITS,
+                     [&](size_t prefix) {
+                         if (FIRST_LEVEL.states[prefix] != FirstLevelState::SecondLevel) {
+                             return;
+                         }
+                         auto& second_level{
+                             table.second_level[FIRST_LEVEL.entries[prefix] & ~SECOND_LEVEL_FLAG]};
+                         ForEachMatch(mask & SECOND_LEVEL_MASK, value & SECOND_LEVEL_MASK,
+                                      SECOND_LEVEL_BITS, [&](size_t suffix) {
+                                          second_level[suffix] = static_cast<u16>(it->opcode);
+                                      });
+                     });
+    }
+    return table;
 }
-const auto FAST_LOOKUP_TABLE{MakeFastLookupTable()};
+constexpr DecodeTable DECODE_TABLE{MakeDecodeTable()};
 } // Anonymous namespace
 
 Opcode Decode(u64 insn) {
-    const auto& table{(*FAST_LOOKUP_TABLE)[ToFastLookupIndex(insn)]};
-    const auto it{std::ranges::find_if(
-        table, [insn](const InstInfo& info) { return (insn & info.Mask()) == info.Value(); })};
-    if (it == table.end()) {
+    const size_t index{ToFastLookupIndex(insn)};
+    u16 entry{DECODE_TABLE.first_level[index >> SECOND_LEVEL_BITS]};
+    if ((entry & SECOND_LEVEL_FLAG) != 0) {
+        entry = DECODE_TABLE.second_level[entry & ~SECOND_LEVEL_FLAG][index & SECOND_LEVEL_MASK];
+    }
+    if (entry == INVALID_ENTRY) {
         throw NotImplementedException("Instruction 0x{:016x} is unknown / unimplemented", insn);
     }
-    return it->opcode;
+    return static_cast<Opcode>(entry);
 }
 
 } // namespace Shader::Maxwell
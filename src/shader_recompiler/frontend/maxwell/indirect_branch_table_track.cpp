@@ -5,7 +5,6 @@
 
 #include "common/common_types.h"
 #include "shader_recompiler/exception.h"
-#include "shader_recompiler/frontend/maxwell/decode.h"
 #include "shader_recompiler/frontend/maxwell/indirect_branch_table_track.h"
 #include "shader_recompiler/frontend/maxwell/opcodes.h"
 #include "shader_recompiler/frontend/maxwell/translate/impl/load_constant.h"
@@ -22,47 +21,48 @@ union Encoding {
 };
 
 template <typename Callable>
-std::optional<u64> Track(Environment& env, Location block_begin, Location& pos, Callable&& func) {
+std::optional<u64> Track(InstructionCache& cache, Location block_begin, Location& pos,
+                         Callable&& func) {
     while (pos >= block_begin) {
-        const u64 insn{env.ReadInstruction(pos.Offset())};
+        const DecodedInstruction insn{cache.Get(pos)};
         --pos;
-        if (func(insn, Decode(insn))) {
-            return insn;
+        if (func(insn.raw, insn.opcode)) {
+            return insn.raw;
         }
     }
     return std::nullopt;
 }
 
-std::optional<u64> TrackLDC(Environment& env, Location block_begin, Location& pos,
+std::optional<u64> TrackLDC(InstructionCache& cache, Location block_begin, Location& pos,
                             IR::Reg brx_reg) {
-    return Track(env, block_begin, pos, [brx_reg](u64 insn, Opcode opcode) {
+    return Track(cache, block_begin, pos, [brx_reg](u64 insn, Opcode opcode) {
         const LDC::Encoding ldc{insn};
         return opcode == Opcode::LDC && ldc.dest_reg == brx_reg && ldc.size == LDC::Size::B32 &&
                ldc.mode == LDC::Mode::Default;
     });
 }
 
-std::optional<u64> TrackSHL(Environment& env, Location block_begin, Location& pos,
+std::optional<u64> TrackSHL(InstructionCache& cache, Location block_begin, Location& pos,
                             IR::Reg ldc_reg) {
-    return Track(env, block_begin, pos, [ldc_reg](u64 insn, Opcode opcode) {
+    return Track(cache, block_begin, pos, [ldc_reg](u64 insn, Opcode opcode) {
         const Encoding shl{insn};
         return opcode == Opcode::SHL_imm && shl.dest_reg == ldc_reg;
     });
 }
 
-std::optional<u64> TrackIMNMX(Environment& env, Location block_begin, Location& pos,
+std::optional<u64> TrackIMNMX(InstructionCache& cache, Location block_begin, Location& pos,
                               IR::Reg shl_reg) {
-    return Track(env, block_begin, pos, [shl_reg](u64 insn, Opcode opcode) {
+    return Track(cache, block_begin, pos, [shl_reg](u64 insn, Opcode opcode) {
         const Encoding imnmx{insn};
         return opcode == Opcode::IMNMX_imm && imnmx.dest_reg == shl_reg;
     });
 }
 } // Anonymous namespace
 
-std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(Environment& env, Location brx_pos,
+std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(InstructionCache& cache,
+                                                                Location brx_pos,
                                                                 Location block_begin) {
-    const u64 brx_insn{env.ReadInstruction(brx_pos.Offset())};
-    const Opcode brx_opcode{Decode(brx_insn)};
+    const auto [brx_insn, brx_opcode]{cache.Get(brx_pos)};
     if (brx_opcode != Opcode::BRX && brx_opcode != Opcode::JMX) {
         throw LogicError("Tracked instruction is not BRX or JMX");
     }
@@ -70,7 +70,7 @@ std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(Environment& env
     const s32 brx_offset{static_cast<s32>(Encoding{brx_insn}.brx_offset)};
 
     Location pos{brx_pos};
-    const std::optional<u64> ldc_insn{TrackLDC(env, block_begin, pos, brx_reg)};
+    const std::optional<u64> ldc_insn{TrackLDC(cache, block_begin, pos, brx_reg)};
     if (!ldc_insn) {
         return std::nullopt;
     }
@@ -79,14 +79,14 @@ std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(Environment& env
     const u32 cbuf_offset{static_cast<u32>(static_cast<s32>(ldc.offset.Value()))};
     const IR::Reg ldc_reg{ldc.src_reg};
 
-    const std::optional<u64> shl_insn{TrackSHL(env, block_begin, pos, ldc_reg)};
+    const std::optional<u64> shl_insn{TrackSHL(cache, block_begin, pos, ldc_reg)};
     if (!shl_insn) {
         return std::nullopt;
     }
     const Encoding shl{*shl_insn};
     const IR::Reg shl_reg{shl.src_reg};
 
-    const std::optional<u64> imnmx_insn{TrackIMNMX(env, block_begin, pos, shl_reg)};
+    const std::optional<u64> imnmx_insn{TrackIMNMX(cache, block_begin, pos, shl_reg)};
     if (!imnmx_insn) {
         return std::nullopt;
     }
@@ -6,8 +6,8 @@
 #include <optional>
 
 #include "common/common_types.h"
-#include "shader_recompiler/environment.h"
 #include "shader_recompiler/frontend/ir/reg.h"
+#include "shader_recompiler/frontend/maxwell/instruction_cache.h"
 #include "shader_recompiler/frontend/maxwell/location.h"
 
 namespace Shader::Maxwell {
@@ -20,7 +20,8 @@ struct IndirectBranchTableInfo {
     IR::Reg branch_reg{};
 };
 
-std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(Environment& env, Location brx_pos,
+std::optional<IndirectBranchTableInfo> TrackIndirectBranchTable(InstructionCache& cache,
+                                                                Location brx_pos,
                                                                 Location block_begin);
 
 } // namespace Shader::Maxwell
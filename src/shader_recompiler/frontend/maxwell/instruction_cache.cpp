@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "shader_recompiler/frontend/maxwell/decode.h"
+#include "shader_recompiler/frontend/maxwell/instruction_cache.h"
+
+namespace Shader::Maxwell {
+
+InstructionCache::InstructionCache(Environment& env_, Location start_address)
+    : env{env_}, base_offset{start_address.Offset()} {}
+
+DecodedInstruction InstructionCache::Get(Location pc) {
+    if (pc.Offset() < base_offset) {
+        // Functions placed before the entry point are rare, don't cache them
+        const u64 raw{env.ReadInstruction(pc.Offset())};
+        return {raw, Decode(raw)};
+    }
+    const size_t index{(pc.Offset() - base_offset) / 8};
+    const size_t word{index / 64};
+    const u64 bit{u64{1} << (index % 64)};
+    if (word >= decoded_mask.size()) {
+        const size_t new_size{std::max(word + 1, decoded_mask.size() * 2)};
+        decoded_mask.resize(new_size);
+        instructions.resize(new_size * 64);
+    }
+    if ((decoded_mask[word] & bit) == 0) {
+        const u64 raw{env.ReadInstruction(pc.Offset())};
+        instructions[index] = {raw, Decode(raw)};
+        decoded_mask[word] |= bit;
+    }
+    return instructions[index];
+}
+
+} // namespace Shader::Maxwell
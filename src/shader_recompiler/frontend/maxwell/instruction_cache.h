@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "shader_recompiler/environment.h"
+#include "shader_recompiler/frontend/maxwell/location.h"
+#include "shader_recompiler/frontend/maxwell/opcodes.h"
+
+namespace Shader::Maxwell {
+
+struct DecodedInstruction {
+    u64 raw;
+    Opcode opcode;
+};
+
+/// Reads and decodes shader instructions once, so passes walking the same instructions several
+/// times (control flow analysis, indirect branch tracking) don't go through the environment and
+/// the decoder again.
+class InstructionCache {
+public:
+    explicit InstructionCache(Environment& env, Location start_address);
+
+    [[nodiscard]] DecodedInstruction Get(Location pc);
+
+private:
+    Environment& env;
+    u32 base_offset;
+    std::vector<DecodedInstruction> instructions;
+    std::vector<u64> decoded_mask;
+};
+
+} // namespace Shader::Maxwell
@@ -6,6 +6,7 @@
 #include <vector>
 #include <queue>
 
+#include "common/logging/log.h"
 #include "common/settings.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/frontend/ir/basic_block.h"
@@ -50,6 +51,16 @@ void RemoveUnreachableBlocks(IR::Program& program) {
     program.blocks.erase(std::remove_if(begin, end, pred), end);
 }
 
+size_t CountInstructions(const IR::Program& program) {
+    size_t num_insts{};
+    for (const IR::Block* const block : program.blocks) {
+        num_insts += std::ranges::count_if(block->Instructions(), [](const IR::Inst& inst) {
+            return inst.GetOpcode() != IR::Opcode::Identity;
+        });
+    }
+    return num_insts;
+}
+
 void CollectInterpolationInfo(Environment& env, IR::Program& program) {
     if (program.stage != Stage::Fragment) {
         return;
@@ -304,8 +315,14 @@ IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Blo
     if (Settings::values.resolution_info.active) {
         Optimization::RescalingPass(program);
     }
+    const size_t num_insts_before_gvn{Settings::values.renderer_debug ? CountInstructions(program)
+                                                                       : 0};
+    Optimization::LoopInvariantCodeMotionPass(program);
+    Optimization::GlobalValueNumberingPass(program);
     Optimization::DeadCodeEliminationPass(program);
     if (Settings::values.renderer_debug) {
+        LOG_DEBUG(Shader, "Value numbering reduced the instruction count from {} to {}",
+                  num_insts_before_gvn, CountInstructions(program));
         Optimization::VerificationPass(program);
     }
     Optimization::CollectShaderInfoPass(env, program);
@@ -0,0 +1,191 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Immediate dominators computed with the Cooper-Harvey-Kennedy iterative algorithm
+class DominatorTree {
+public:
+    explicit DominatorTree(const IR::Program& program) {
+        const size_t num_blocks{program.post_order_blocks.size()};
+        post_order_index.reserve(num_blocks);
+        for (size_t index = 0; index < num_blocks; ++index) {
+            post_order_index.emplace(program.post_order_blocks[index], index);
+        }
+        // The entry block is the last block in post order
+        idoms.assign(num_blocks, UNDEFINED);
+        if (num_blocks == 0) {
+            return;
+        }
+        idoms[num_blocks - 1] = num_blocks - 1;
+
+        bool changed{true};
+        while (changed) {
+            changed = false;
+            for (size_t index = num_blocks - 1; index-- > 0;) {
+                const IR::Block* const block{program.post_order_blocks[index]};
+                size_t new_idom{UNDEFINED};
+                for (const IR::Block* const pred : block->ImmPredecessors()) {
+                    const auto it{post_order_index.find(pred)};
+                    if (it == post_order_index.end() || idoms[it->second] == UNDEFINED) {
+                        continue;
+                    }
+                    new_idom = new_idom == UNDEFINED ? it->second : Intersect(it->second, new_idom);
+                }
+                if (idoms[index] != new_idom) {
+                    idoms[index] = new_idom;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] bool Dominates(const IR::Block* dominator, const IR::Block* block) const {
+        const size_t dominator_index{post_order_index.at(dominator)};
+        size_t index{post_order_index.at(block)};
+        while (index < dominator_index && idoms[index] != UNDEFINED) {
+            index = idoms[index];
+        }
+        return index == dominator_index;
+    }
+
+private:
+    static constexpr size_t UNDEFINED = std::numeric_limits<size_t>::max();
+
+    [[nodiscard]] size_t Intersect(size_t lhs, size_t rhs) const {
+        while (lhs != rhs) {
+            while (lhs < rhs) {
+                lhs = idoms[lhs];
+            }
+            while (rhs < lhs) {
+                rhs = idoms[rhs];
+            }
+        }
+        return lhs;
+    }
+
+    std::unordered_map<const IR::Block*, size_t> post_order_index;
+    std::vector<size_t> idoms;
+};
+
+struct ValueKey {
+    IR::Opcode opcode{};
+    u32 flags{};
+    std::array<IR::Value, 5> args{};
+
+    bool operator==(const ValueKey&) const = default;
+};
+
+struct ValueKeyHash {
+    size_t operator()(const ValueKey& key) const noexcept {
+        size_t hash{static_cast<size_t>(key.opcode)};
+        boost::hash_combine(hash, key.flags);
+        for (const IR::Value& arg : key.args) {
+            if (const IR::Inst* const inst{arg.TryInstRecursive()}) {
+                boost::hash_combine(hash, inst);
+            } else {
+                boost::hash_combine(hash, static_cast<u32>(arg.Type()));
+            }
+        }
+        return hash;
+    }
+};
+
+bool IsCommutative(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::IAdd64:
+    case IR::Opcode::IMul32:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+    case IR::Opcode::BitwiseXor32:
+    case IR::Opcode::SMin32:
+    case IR::Opcode::UMin32:
+    case IR::Opcode::SMax32:
+    case IR::Opcode::UMax32:
+    case IR::Opcode::IEqual:
+    case IR::Opcode::INotEqual:
+    case IR::Opcode::LogicalOr:
+    case IR::Opcode::LogicalAnd:
+    case IR::Opcode::LogicalXor:
+    case IR::Opcode::FPAdd16:
+    case IR::Opcode::FPAdd32:
+    case IR::Opcode::FPAdd64:
+    case IR::Opcode::FPMul16:
+    case IR::Opcode::FPMul32:
+    case IR::Opcode::FPMul64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ValueKey MakeKey(const IR::Inst& inst) {
+    ValueKey key{
+        .opcode = inst.GetOpcode(),
+        .flags = inst.Flags<u32>(),
+    };
+    const size_t num_args{inst.NumArgs()};
+    for (size_t index = 0; index < num_args; ++index) {
+        key.args[index] = inst.Arg(index).Resolve();
+    }
+    if (IsCommutative(key.opcode)) {
+        // Canonicalize operand order: instructions sorted by address, immediates last
+        const IR::Inst* const lhs{key.args[0].TryInstRecursive()};
+        const IR::Inst* const rhs{key.args[1].TryInstRecursive()};
+        if ((!lhs && rhs) || (lhs && rhs && std::less<const IR::Inst*>{}(rhs, lhs))) {
+            std::swap(key.args[0], key.args[1]);
+        }
+    }
+    return key;
+}
+
+struct Candidate {
+    IR::Inst* inst;
+    const IR::Block* block;
+};
+} // Anonymous namespace
+
+void GlobalValueNumberingPass(IR::Program& program) {
+    const DominatorTree dominator_tree{program};
+    std::unordered_map<ValueKey, boost::container::small_vector<Candidate, 1>, ValueKeyHash>
+        values;
+
+    // Visiting blocks in reverse post order guarantees that dominating definitions are seen
+    // before the instructions they dominate
+    for (auto block_it = program.post_order_blocks.rbegin();
+         block_it != program.post_order_blocks.rend(); ++block_it) {
+        IR::Block* const block{*block_it};
+        for (IR::Inst& inst : block->Instructions()) {
+            if (!inst.IsPure() || inst.HasAssociatedPseudoOperation()) {
+                continue;
+            }
+            auto& candidates{values[MakeKey(inst)]};
+            const auto dominating{std::ranges::find_if(candidates, [&](const Candidate& candidate) {
+                return dominator_tree.Dominates(candidate.block, block);
+            })};
+            if (dominating != candidates.end()) {
+                inst.ReplaceUsesWith(IR::Value{dominating->inst});
+            } else {
+                candidates.push_back(Candidate{&inst, block});
+            }
+        }
+    }
+}
+
+} // namespace Shader::Optimization
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+#include "shader_recompiler/frontend/ir/abstract_syntax_list.h"
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/value.h"
+#include "shader_recompiler/ir_opt/passes.h"
+
+namespace Shader::Optimization {
+namespace {
+/// Returns the block entering the loop from outside, or null when there is not a single one
+IR::Block* FindPreheader(const IR::Block* header, const IR::Block* continue_block) {
+    const auto preds{header->ImmPredecessors()};
+    if (preds.size() != 2) {
+        return nullptr;
+    }
+    if (preds[0] == continue_block) {
+        return preds[1];
+    }
+    return preds[1] == continue_block ? preds[0] : nullptr;
+}
+
+bool IsInvariant(const IR::Inst& inst, const std::unordered_set<const IR::Inst*>& loop_insts) {
+    if (!inst.IsPure() || inst.HasAssociatedPseudoOperation()) {
+        return false;
+    }
+    const size_t num_args{inst.NumArgs()};
+    for (size_t index = 0; index < num_args; ++index) {
+        const IR::Inst* const arg{inst.Arg(index).TryInstRecursive()};
+        if (arg && loop_insts.contains(arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void HoistInvariants(IR::Block* preheader, std::span<IR::Block* const> loop_blocks) {
+    std::unordered_set<const IR::Inst*> loop_insts;
+    for (const IR::Block* const block : loop_blocks) {
+        for (const IR::Inst& inst : block->Instructions()) {
+            loop_insts.insert(&inst);
+        }
+    }
+    // Blocks are in structured order, so the operands of an instruction are visited (and
+    // possibly hoisted) before the instruction itself
+    for (IR::Block* const block : loop_blocks) {
+        for (auto it = block->begin(); it != block->end();) {
+            IR::Inst& inst{*it};
+            if (!IsInvariant(inst, loop_insts)) {
+                ++it;
+                continue;
+            }
+            it = block->Instructions().erase(it);
+            preheader->Instructions().push_back(inst);
+            loop_insts.erase(&inst);
+        }
+    }
+}
+} // Anonymous namespace
+
+void LoopInvariantCodeMotionPass(IR::Program& program) {
+    const IR::AbstractSyntaxList& syntax_list{program.syntax_list};
+    std::vector<IR::Block*> loop_blocks;
+    // Outer loops are visited first, instructions that are only invariant in an inner loop are
+    // hoisted to the inner loop's preheader afterwards
+    for (size_t index = 1; index < syntax_list.size(); ++index) {
+        const IR::AbstractSyntaxNode& node{syntax_list[index]};
+        const IR::AbstractSyntaxNode& header_node{syntax_list[index - 1]};
+        if (node.type != IR::AbstractSyntaxNode::Type::Loop ||
+            header_node.type != IR::AbstractSyntaxNode::Type::Block) {
+            continue;
+        }
+        IR::Block* const header{header_node.data.block};
+        IR::Block* const preheader{FindPreheader(header, node.data.loop.continue_block)};
+        if (!preheader) {
+            continue;
+        }
+        loop_blocks.clear();
+        loop_blocks.push_back(header);
+        size_t depth{0};
+        for (size_t body_index = index + 1; body_index < syntax_list.size(); ++body_index) {
+            const IR::AbstractSyntaxNode& body_node{syntax_list[body_index]};
+            if (body_node.type == IR::AbstractSyntaxNode::Type::Loop) {
+                ++depth;
+            } else if (body_node.type == IR::AbstractSyntaxNode::Type::Repeat) {
+                if (depth == 0) {
+                    break;
+                }
+                --depth;
+            } else if (body_node.type == IR::AbstractSyntaxNode::Type::Block) {
+                loop_blocks.push_back(body_node.data.block);
+            }
+        }
+        HoistInvariants(preheader, loop_blocks);
+    }
+}
+
+} // namespace Shader::Optimization
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/command/data_source/adpcm_decode.h"
+#include "common/common_types.h"
+#include "common/literals.h"
+
+namespace {
+using namespace AudioCore::Renderer;
+using AudioCore::CpuAddr;
+using namespace Common::Literals;
+
+constexpr CpuAddr BaseAddress = 0x8000000;
+
+/// Guest memory backed by a host buffer
+class FakeMemory {
+public:
+    explicit FakeMemory(size_t size) : data(size) {}
+
+    u8* GetSpan(u64 address, size_t size) {
+        return IsValid(address, size) ? data.data() + (address - BaseAddress) : nullptr;
+    }
+
+    bool ReadBlockUnsafe(u64 address, void* dest, size_t size) {
+        REQUIRE(IsValid(address, size));
+        std::memcpy(dest, data.data() + (address - BaseAddress), size);
+        return true;
+    }
+
+    u8& operator[](u64 address) {
+        return data[address - BaseAddress];
+    }
+
+    size_t Size() const {
+        return data.size();
+    }
+
+private:
+    bool IsValid(u64 address, size_t size) const {
+        return address >= BaseAddress && address + size <= BaseAddress + data.size();
+    }
+
+    std::vector<u8> data;
+};
+
+/// Fills the memory with random frames whose headers select one of the 8 coefficient pairs
+void FillFrames(FakeMemory& memory, std::mt19937& rng) {
+    for (u64 offset = 0; offset < memory.Size(); offset++) {
+        memory[BaseAddress + offset] = static_cast<u8>(rng());
+        if (offset % AdpcmBytesPerFrame == 0) {
+            memory[BaseAddress + offset] &= 0x7F;
+        }
+    }
+}
+} // Anonymous namespace
+
+TEST_CASE("ADPCM: Cached decoding matches decoding every request", "[audio_core]") {
+    std::mt19937 rng{1234};
+    FakeMemory memory{1_MiB};
+    FillFrames(memory, rng);
+
+    std::array<s16, 16> coefficients;
+    for (auto& coefficient : coefficients) {
+        coefficient = static_cast<s16>(rng() % 4096 - 2048);
+    }
+
+    AdpcmDecodeCache cache;
+    size_t cached_requests = 0;
+    for (u32 voice = 0; voice < 200; voice++) {
+        VoiceState voice_state{};
+        AdpcmDecodeCache::Entry& entry = cache.GetEntry(&voice_state);
+
+        const VoiceState::AdpcmContext guest_context{
+            .header = static_cast<u16>(memory[BaseAddress] & 0x7F),
+            .yn0 = static_cast<s16>(rng()),
+            .yn1 = static_cast<s16>(rng()),
+        };
+        VoiceState::AdpcmContext context{};
+        VoiceState::AdpcmContext cached_context{};
+        const bool reload_context = rng() % 2 == 0;
+
+        CpuAddr buffer = BaseAddress + (rng() % 1000) * AdpcmBytesPerFrame;
+        const u32 start = rng() % 3 == 0 ? static_cast<u32>(rng() % 40)
+                                         : static_cast<u32>(rng() % 3) * AdpcmSamplesPerFrame;
+        const u32 end = start + 1 + static_cast<u32>(rng() % (rng() % 2 == 0 ? 200 : 5000));
+        u32 offset = 0;
+
+        for (u32 call = 0; call < 400; call++) {
+            if (offset == 0 && reload_context) {
+                context = guest_context;
+                cached_context = guest_context;
+            }
+            // The guest rewrites the sound, or switches to another buffer
+            if (rng() % 150 == 0) {
+                memory[buffer + rng() % 64] ^= 0x10;
+            }
+            if (rng() % 300 == 0) {
+                buffer = BaseAddress + (rng() % 1000) * AdpcmBytesPerFrame;
+                offset = 0;
+                continue;
+            }
+
+            const DecodeArg request{
+                .buffer = buffer,
+                .buffer_size = 512_KiB,
+                .start_offset = start,
+                .end_offset = end,
+                .channel_count = 1,
+                .coefficients = coefficients,
+                .adpcm_context = &context,
+                .target_channel = 0,
+                .offset = offset,
+                .samples_to_read = 1 + static_cast<u32>(rng() % 300),
+            };
+            DecodeArg cached_request = request;
+            cached_request.adpcm_context = &cached_context;
+
+            std::array<s16, 0x400> output{};
+            std::array<s16, 0x400> cached_output{};
+            const u32 decoded = DecodeAdpcm(memory, output, request, nullptr, nullptr);
+            const u32 cached_decoded =
+                DecodeAdpcm(memory, cached_output, cached_request, &cache, &entry);
+
+            REQUIRE(decoded == cached_decoded);
+            REQUIRE(output == cached_output);
+            REQUIRE(context.header == cached_context.header);
+            REQUIRE(context.yn0 == cached_context.yn0);
+            REQUIRE(context.yn1 == cached_context.yn1);
+
+            if (!entry.samples.empty()) {
+                cached_requests++;
+            }
+            offset += decoded;
+            if (decoded == 0 || offset >= end - start) {
+                offset = 0;
+            }
+        }
+    }
+    REQUIRE(cached_requests > 0);
+}
@@ -0,0 +1,214 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/common/audio_renderer_parameter.h"
+#include "audio_core/renderer/behavior/behavior_info.h"
+#include "audio_core/renderer/command/command_buffer.h"
+#include "audio_core/renderer/command/command_generator.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/command_processing_time_estimator.h"
+#include "audio_core/renderer/effect/effect_context.h"
+#include "audio_core/renderer/memory/memory_pool_info.h"
+#include "audio_core/renderer/mix/mix_context.h"
+#include "audio_core/renderer/sink/sink_context.h"
+#include "audio_core/renderer/splitter/splitter_context.h"
+#include "audio_core/renderer/voice/voice_context.h"
+#include "common/common_types.h"
+
+namespace {
+using namespace AudioCore;
+using namespace AudioCore::Renderer;
+
+constexpr u32 SampleCount = 240;
+
+/// Renders a single mono voice into one mix, holding everything the command generator needs
+class VoiceRenderer {
+public:
+    explicit VoiceRenderer(s16 buffer_count_)
+        : buffer_count{buffer_count_}, mix{{}, 0, behavior},
+          mix_buffers((buffer_count + 1) * SampleCount),
+          estimator{SampleCount, static_cast<u32>(buffer_count)} {
+        // The mix ramps write their last sample through the memory pool into the voice state
+        memory_pool.SetCpuAddress(CpuAddr(&voice_state), sizeof(VoiceState));
+        memory_pool.SetDspAddress(CpuAddr(&voice_state));
+
+        command_buffer.command_list = commands;
+        command_buffer.sample_count = SampleCount;
+        command_buffer.sample_rate = TargetSampleRate;
+        command_buffer.memory_pool = &memory_pool;
+        command_buffer.time_estimator = &estimator;
+        command_buffer.behavior = &behavior;
+
+        render_context.mix_buffer_count = buffer_count;
+        render_context.behavior = &behavior;
+        render_context.depop_buffer = depop_buffer;
+        render_context.memory_pool_info = &memory_pool;
+
+        voice.in_use = true;
+        voice.channel_count = 1;
+        voice.mix_id = 0;
+        voice.sample_format = SampleFormat::PcmInt16;
+        voice_context.Initialize(sorted_voice, std::span{&voice, 1}, std::span{&resource, 1},
+                                 std::span{&cpu_state, 1}, std::span{&voice_state, 1}, 1);
+
+        mix.mix_id = 0;
+        mix.buffer_count = buffer_count;
+        mix_context.Initialize(sorted_mix, std::span{&mix, 1}, 1, {}, 0, {}, 0, {}, 0);
+
+        for (size_t i = 0; i < mix_buffers.size(); i++) {
+            mix_buffers[i] = static_cast<s32>(i * 37 % 2001) - 1000;
+        }
+        for (size_t i = 0; i < voice_state.previous_samples.size(); i++) {
+            voice_state.previous_samples[i] = 0x5A5A + static_cast<s32>(i);
+        }
+    }
+
+    VoiceRenderer(const VoiceRenderer&) = delete;
+    VoiceRenderer& operator=(const VoiceRenderer&) = delete;
+
+    void SetVolumes(f32 prev_volume, f32 volume, std::span<const f32> prev_mix_volumes,
+                    std::span<const f32> mix_volumes) {
+        voice.prev_volume = prev_volume;
+        voice.volume = volume;
+        std::ranges::copy(prev_mix_volumes, resource.prev_mix_volumes.begin());
+        std::ranges::copy(mix_volumes, resource.mix_volumes.begin());
+    }
+
+    /// Generates the voice through the command generator, which may cull its mixing
+    bool GenerateCulled() {
+        return Generator().GenerateVoiceCommand(voice);
+    }
+
+    /// Generates the volume and mix ramps the voice would use if it was never culled
+    void GenerateUnculled() {
+        auto generator{Generator()};
+        command_buffer.GenerateVolumeRampCommand(voice.node_id, voice, buffer_count, 15);
+        generator.GenerateVoiceMixCommand(resource.mix_volumes, resource.prev_mix_volumes,
+                                          voice_state, mix.buffer_offset, buffer_count,
+                                          buffer_count, voice.node_id);
+    }
+
+    /// Runs the mixing commands, the data source output is stood in for by the filled buffers
+    void Process() {
+        AudioCore::ADSP::AudioRenderer::CommandListProcessor processor;
+        processor.sample_count = SampleCount;
+        processor.mix_buffers = mix_buffers;
+
+        u64 offset{0};
+        for (u32 i = 0; i < command_buffer.count; i++) {
+            auto& command{*reinterpret_cast<ICommand*>(&commands[offset])};
+            switch (command.type) {
+            case CommandId::VolumeRamp:
+            case CommandId::MixRamp:
+            case CommandId::MixRampGrouped:
+                command.Process(processor);
+                break;
+            default:
+                break;
+            }
+            offset += command.size;
+        }
+    }
+
+    /// The mix buffers, without the voice channel buffer after them
+    std::span<const s32> MixBuffers() const {
+        return std::span{mix_buffers}.first(buffer_count * SampleCount);
+    }
+
+    const std::array<s32, MaxMixBuffers>& PreviousSamples() const {
+        return voice_state.previous_samples;
+    }
+
+private:
+    CommandGenerator Generator() {
+        return CommandGenerator(command_buffer, header, render_context, voice_context,
+                                mix_context, effect_context, sink_context, splitter_context,
+                                nullptr);
+    }
+
+    s16 buffer_count;
+    BehaviorInfo behavior;
+    MemoryPoolInfo memory_pool{MemoryPoolInfo::Location::DSP};
+    VoiceInfo voice;
+    std::array<VoiceInfo*, 1> sorted_voice{};
+    VoiceChannelResource resource{0};
+    VoiceState cpu_state{};
+    VoiceState voice_state{};
+    MixInfo mix;
+    std::array<MixInfo*, 1> sorted_mix{};
+    VoiceContext voice_context;
+    MixContext mix_context;
+    EffectContext effect_context;
+    SinkContext sink_context;
+    SplitterContext splitter_context;
+    std::vector<s32> mix_buffers;
+    std::array<s32, MaxMixBuffers> depop_buffer{};
+    std::vector<u8> commands = std::vector<u8>(0x4000);
+    CommandProcessingTimeEstimatorVersion1 estimator;
+    CommandBuffer command_buffer;
+    CommandListHeader header{};
+    AudioRendererSystemContext render_context{};
+};
+
+/// Renders a voice with and without culling, and checks both leave the same mix and depop state
+void RequireCullingMatches(s16 buffer_count, f32 prev_volume, f32 volume,
+                           std::span<const f32> prev_mix_volumes,
+                           std::span<const f32> mix_volumes) {
+    VoiceRenderer culled{buffer_count};
+    culled.SetVolumes(prev_volume, volume, prev_mix_volumes, mix_volumes);
+    REQUIRE(culled.GenerateCulled());
+    culled.Process();
+
+    VoiceRenderer unculled{buffer_count};
+    unculled.SetVolumes(prev_volume, volume, prev_mix_volumes, mix_volumes);
+    unculled.GenerateUnculled();
+    unculled.Process();
+
+    REQUIRE(std::ranges::equal(culled.MixBuffers(), unculled.MixBuffers()));
+    REQUIRE(culled.PreviousSamples() == unculled.PreviousSamples());
+}
+
+/// Mix volumes with every other buffer left at zero, which single mix ramps are not made for
+std::array<f32, MaxMixBuffers> AlternatingVolumes(f32 volume) {
+    std::array<f32, MaxMixBuffers> volumes{};
+    for (size_t i = 0; i < volumes.size(); i += 2) {
+        volumes[i] = volume;
+    }
+    return volumes;
+}
+} // Anonymous namespace
+
+TEST_CASE("CommandGenerator: Culling a silent voice matches mixing it", "[audio_core]") {
+    const std::array<f32, MaxMixBuffers> silent{};
+    const auto prev_mix_volumes{AlternatingVolumes(0.5f)};
+    const auto mix_volumes{AlternatingVolumes(0.75f)};
+
+    // Single mix ramps for up to 8 buffers, a grouped mix ramp above that
+    for (const s16 buffer_count : std::array<s16, 4>{2, 6, 12, 24}) {
+        // Zero voice volume with audible mix volumes
+        RequireCullingMatches(buffer_count, 0.0f, 0.0f, prev_mix_volumes, mix_volumes);
+        // Audible voice volume with zero mix volumes
+        RequireCullingMatches(buffer_count, 1.0f, 0.5f, silent, silent);
+    }
+}
+
+TEST_CASE("CommandGenerator: Audible voices are not culled", "[audio_core]") {
+    const auto mix_volumes{AlternatingVolumes(0.75f)};
+
+    VoiceRenderer ramping_in{2};
+    ramping_in.SetVolumes(0.0f, 1.0f, mix_volumes, mix_volumes);
+    REQUIRE(!ramping_in.GenerateCulled());
+
+    const std::array<f32, MaxMixBuffers> silent{};
+    VoiceRenderer mix_ramping_out{12};
+    mix_ramping_out.SetVolumes(1.0f, 1.0f, mix_volumes, silent);
+    REQUIRE(!mix_ramping_out.GenerateCulled());
+}
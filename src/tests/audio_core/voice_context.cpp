@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/renderer/voice/voice_context.h"
+#include "common/common_types.h"
+
+namespace {
+using AudioCore::Renderer::VoiceContext;
+using AudioCore::Renderer::VoiceInfo;
+
+class VoiceSorter {
+public:
+    explicit VoiceSorter(u32 count) : voices(count), sorted(count) {
+        context.Initialize(sorted, voices, {}, {}, {}, count);
+    }
+
+    VoiceInfo& Voice(u32 index) {
+        return voices[index];
+    }
+
+    /// Sorts the voices and returns the resulting order as voice indices
+    std::vector<u32> Sort() {
+        context.SortInfo();
+        std::vector<u32> order;
+        for (u32 i = 0; i < context.GetCount(); i++) {
+            order.push_back(static_cast<u32>(context.GetSortedInfo(i) - voices.data()));
+        }
+        return order;
+    }
+
+    /// Returns whether the order is sorted by priority, then sort order, both descending
+    bool IsSorted(const std::vector<u32>& order) const {
+        return std::ranges::is_sorted(order, [this](u32 lhs, u32 rhs) {
+            const VoiceInfo& a = voices[lhs];
+            const VoiceInfo& b = voices[rhs];
+            return a.priority != b.priority ? a.priority > b.priority
+                                            : a.sort_order > b.sort_order;
+        });
+    }
+
+private:
+    std::vector<VoiceInfo> voices;
+    std::vector<VoiceInfo*> sorted;
+    VoiceContext context;
+};
+
+bool IsPermutation(std::vector<u32> order) {
+    std::ranges::sort(order);
+    for (u32 i = 0; i < order.size(); i++) {
+        if (order[i] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+} // Anonymous namespace
+
+TEST_CASE("VoiceContext: Sorting follows priority changes", "[audio_core]") {
+    VoiceSorter sorter{6};
+    for (u32 i = 0; i < 6; i++) {
+        sorter.Voice(i).priority = static_cast<s32>(i);
+    }
+    const std::vector<u32> initial{5, 4, 3, 2, 1, 0};
+    REQUIRE(sorter.Sort() == initial);
+
+    // Unchanged priorities keep the previous order
+    REQUIRE(sorter.Sort() == initial);
+
+    sorter.Voice(0).priority = 10;
+    sorter.Voice(5).priority = -1;
+    sorter.Voice(3).priority = 1;
+    // Voices 3 and 1 now share a priority and keep their previous relative order
+    const std::vector<u32> changed{0, 4, 2, 3, 1, 5};
+    REQUIRE(sorter.Sort() == changed);
+}
+
+TEST_CASE("VoiceContext: Equal priorities are ordered by sort order", "[audio_core]") {
+    VoiceSorter sorter{5};
+    for (u32 i = 0; i < 5; i++) {
+        sorter.Voice(i).priority = 1;
+        sorter.Voice(i).sort_order = static_cast<s32>(i);
+    }
+    const std::vector<u32> initial{4, 3, 2, 1, 0};
+    REQUIRE(sorter.Sort() == initial);
+
+    sorter.Voice(1).sort_order = 7;
+    const std::vector<u32> changed{1, 4, 3, 2, 0};
+    REQUIRE(sorter.Sort() == changed);
+
+    // Voices tied on both keep their previous relative order while others move around them
+    sorter.Voice(2).sort_order = 3;
+    const auto tied = sorter.Sort();
+    REQUIRE(sorter.IsSorted(tied));
+    const auto tied_begin = std::ranges::find(tied, 3u);
+    const auto tied_other = std::ranges::find(tied, 2u);
+    REQUIRE(tied_other == tied_begin + 1);
+
+    sorter.Voice(0).priority = 2;
+    sorter.Voice(4).priority = 0;
+    const auto order = sorter.Sort();
+    REQUIRE(order.front() == 0);
+    REQUIRE(order.back() == 4);
+    REQUIRE(std::ranges::find(order, 2u) == std::ranges::find(order, 3u) + 1);
+}
+
+TEST_CASE("VoiceContext: Reordering every voice falls back to a full sort", "[audio_core]") {
+    constexpr u32 VoiceCount = 64;
+    VoiceSorter sorter{VoiceCount};
+    for (u32 i = 0; i < VoiceCount; i++) {
+        sorter.Voice(i).priority = static_cast<s32>(i);
+    }
+    auto order = sorter.Sort();
+    REQUIRE(order.front() == VoiceCount - 1);
+    REQUIRE(sorter.IsSorted(order));
+
+    // Reversing the order needs far more moves than the insertion sort allows
+    for (u32 i = 0; i < VoiceCount; i++) {
+        sorter.Voice(i).priority = -static_cast<s32>(i);
+    }
+    order = sorter.Sort();
+    REQUIRE(order.front() == 0);
+    REQUIRE(order.back() == VoiceCount - 1);
+    REQUIRE(sorter.IsSorted(order));
+    REQUIRE(IsPermutation(order));
+}
+
+TEST_CASE("VoiceContext: Random priority changes stay sorted", "[audio_core]") {
+    constexpr u32 VoiceCount = 96;
+    std::mt19937 rng{42};
+    VoiceSorter sorter{VoiceCount};
+    for (u32 i = 0; i < VoiceCount; i++) {
+        sorter.Voice(i).priority = static_cast<s32>(rng() % 8);
+        sorter.Voice(i).sort_order = static_cast<s32>(rng() % 4);
+    }
+    for (u32 update = 0; update < 100; update++) {
+        // Mostly small changes which take the incremental path, with the odd full reshuffle
+        const u32 changes = update % 10 == 9 ? VoiceCount : static_cast<u32>(rng() % 4);
+        for (u32 i = 0; i < changes; i++) {
+            VoiceInfo& voice = sorter.Voice(static_cast<u32>(rng() % VoiceCount));
+            voice.priority = static_cast<s32>(rng() % 8);
+            voice.sort_order = static_cast<s32>(rng() % 4);
+        }
+        const auto order = sorter.Sort();
+        REQUIRE(sorter.IsSorted(order));
+        REQUIRE(IsPermutation(order));
+    }
+}
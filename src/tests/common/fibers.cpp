@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/common_types.h"
@@ -310,4 +311,34 @@ TEST_CASE("Fibers::Rewind", "[common]") {
     REQUIRE(test_control.rewinded);
 }
 
+static void RunShortLivedFiber() {
+    auto thread_fiber = Fiber::ThreadToFiber();
+    std::shared_ptr<Fiber> work_fiber;
+    work_fiber = std::make_shared<Fiber>([&] { Fiber::YieldTo(work_fiber, *thread_fiber); });
+    Fiber::YieldTo(thread_fiber, *work_fiber);
+    thread_fiber->Exit();
+}
+
+/** This test checks that the stacks of destroyed fibers are recycled instead of being mapped
+ *  again for every new fiber.
+ */
+TEST_CASE("Fibers::StackReuse", "[common]") {
+    RunShortLivedFiber();
+    const auto before = Fiber::GetStatistics();
+    for (int i = 0; i < 100; ++i) {
+        RunShortLivedFiber();
+    }
+    const auto after = Fiber::GetStatistics();
+    REQUIRE(after.live_fibers == before.live_fibers);
+    REQUIRE(after.allocated_stacks == before.allocated_stacks);
+    REQUIRE(after.pooled_stacks > 0);
+    REQUIRE(after.stack_memory == before.stack_memory);
+}
+
+TEST_CASE("Fibers::CreationBenchmark", "[common][.benchmark]") {
+    BENCHMARK("Create, run and destroy a fiber") {
+        RunShortLivedFiber();
+    };
+}
+
 } // namespace Common
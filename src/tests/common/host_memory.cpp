@@ -1,6 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
 
 #include "common/host_memory.h"
@@ -184,3 +188,46 @@ TEST_CASE("HostMemory: Partial sparse middle unmap and check bindings", "[common
     REQUIRE(ptr[0x0000] == 19);
     REQUIRE(ptr[0x3fff] == 12);
 }
+
+TEST_CASE("HostMemory: Partial unmap of a huge page aligned mapping", "[common]") {
+    HostMemory mem(BACKING_SIZE, VIRTUAL_SIZE, true);
+    mem.Map(0x400000, 0x200000, 0x400000, PERMS, HEAP);
+
+    volatile u8* const ptr = mem.VirtualBasePointer() + 0x400000;
+    ptr[0x000000] = 19;
+    ptr[0x200000] = 23;
+    ptr[0x3fffff] = 12;
+
+    mem.Unmap(0x500000, 0x1000, HEAP);
+
+    REQUIRE(ptr[0x000000] == 19);
+    REQUIRE(ptr[0x200000] == 23);
+    REQUIRE(ptr[0x3fffff] == 12);
+
+    mem.Map(0x500000, 0x300000, 0x1000, PERMS, HEAP);
+    ptr[0x100000] = 31;
+    REQUIRE(ptr[0x100000] == 31);
+}
+
+TEST_CASE("HostMemory: Random access throughput", "[common][.benchmark]") {
+    static constexpr size_t WORKING_SET = 1_GiB;
+    for (const bool huge_pages : {false, true}) {
+        HostMemory mem(WORKING_SET, VIRTUAL_SIZE, huge_pages);
+        mem.Map(0, 0, WORKING_SET, PERMS, HEAP);
+        u8* const data = mem.VirtualBasePointer();
+        std::memset(data, 1, WORKING_SET);
+
+        // Scattered accesses miss the TLB on nearly every load with 4K pages
+        const std::string name = huge_pages ? "1M random reads, huge pages"
+                                            : "1M random reads, 4K pages";
+        BENCHMARK(name.c_str()) {
+            u64 state = 0x9E3779B97F4A7C15ULL;
+            u64 sum = 0;
+            for (size_t i = 0; i < 1'000'000; ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                sum += data[(state >> 16) % WORKING_SET];
+            }
+            return sum;
+        };
+    }
+}
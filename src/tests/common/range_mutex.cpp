@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "common/range_mutex.h"
+
+namespace {
+using namespace Common::Literals;
+
+constexpr size_t NumThreads = 4;
+constexpr u64 PageSize = 4_KiB;
+constexpr u64 AddressSpaceSize = 64_MiB;
+constexpr size_t NumPages = AddressSpaceSize / PageSize;
+
+struct Range {
+    u64 address;
+    u64 size;
+};
+
+Range RandomRange(std::mt19937_64& rng) {
+    // Mostly small ranges, with the occasional one spanning many stripes
+    const u64 max_pages = rng() % 16 == 0 ? NumPages / 2 : 64;
+    const u64 num_pages = 1 + rng() % max_pages;
+    const u64 first_page = rng() % (NumPages - num_pages + 1);
+    return {first_page * PageSize, num_pages * PageSize};
+}
+} // Anonymous namespace
+
+TEST_CASE("RangeMutex: Overlapping ranges are mutually exclusive", "[common]") {
+    Common::RangeMutex mutex;
+    std::vector<std::atomic<u32>> owners(NumPages);
+    std::vector<u32> counters(NumPages);
+    std::array<std::vector<u32>, NumThreads> expected;
+    std::atomic<size_t> violations{};
+
+    {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < NumThreads; ++thread) {
+            threads.emplace_back([&, thread] {
+                std::mt19937_64 rng{thread};
+                auto& thread_expected = expected[thread];
+                thread_expected.resize(NumPages);
+                const u32 id = static_cast<u32>(thread + 1);
+                for (size_t i = 0; i < 2000; ++i) {
+                    const Range range = RandomRange(rng);
+                    const u64 first_page = range.address / PageSize;
+                    const u64 last_page = first_page + range.size / PageSize;
+
+                    Common::ScopedRangeLock lk{mutex, range.address, range.size};
+                    for (u64 page = first_page; page < last_page; ++page) {
+                        u32 no_owner = 0;
+                        if (!owners[page].compare_exchange_strong(no_owner, id)) {
+                            ++violations;
+                        }
+                        ++counters[page];
+                        ++thread_expected[page];
+                    }
+                    for (u64 page = first_page; page < last_page; ++page) {
+                        owners[page].store(0);
+                    }
+                }
+            });
+        }
+    }
+
+    REQUIRE(violations == 0);
+    for (size_t page = 0; page < NumPages; ++page) {
+        u32 total = 0;
+        for (const auto& thread_expected : expected) {
+            total += thread_expected[page];
+        }
+        REQUIRE(counters[page] == total);
+    }
+}
+
+TEST_CASE("RangeMutex: Disjoint ranges do not wait on each other", "[common]") {
+    Common::RangeMutex mutex;
+    Common::ScopedRangeLock outer{mutex, 0, 2_MiB};
+
+    // Locking a range in another block from a different thread must not block on `outer`
+    std::atomic<bool> locked{};
+    std::jthread thread{[&] {
+        Common::ScopedRangeLock inner{mutex, 2_MiB, PageSize};
+        locked = true;
+    }};
+    thread.join();
+    REQUIRE(locked);
+}
+
+TEST_CASE("RangeMutex: Lock throughput", "[common][.benchmark]") {
+    Common::RangeMutex mutex;
+
+    // Emulates the GPU thread, shader/texture workers and CPU cores registering cached regions
+    BENCHMARK("100000 small range locks on each of 4 threads") {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < NumThreads; ++thread) {
+            threads.emplace_back([&mutex, thread] {
+                std::mt19937_64 rng{thread};
+                for (size_t i = 0; i < 100000; ++i) {
+                    const u64 address = (rng() % NumPages) * PageSize;
+                    Common::ScopedRangeLock lk{mutex, address, 16 * PageSize};
+                }
+            });
+        }
+    };
+}
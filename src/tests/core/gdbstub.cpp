@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <fmt/format.h>
+
+#include "common/common_types.h"
+#include "common/hex_util.h"
+#include "common/literals.h"
+#include "core/core.h"
+#include "core/debugger/debugger_interface.h"
+#include "core/debugger/gdbstub.h"
+#include "core/file_sys/program_metadata.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
+
+namespace {
+using namespace Common::Literals;
+using namespace Kernel;
+
+constexpr size_t CodeSize = 1_MiB;
+constexpr size_t TransferSize = 64_KiB;
+
+/// A client connection which hands the replies of the stub straight back to the test
+class LoopbackBackend final : public Core::DebuggerBackend {
+public:
+    std::span<const u8> ReadFromClient() override {
+        // Every packet is sent whole, so the stub never waits for more
+        return {};
+    }
+
+    void WriteToClient(std::span<const u8> data) override {
+        received.append(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+
+    KThread* GetActiveThread() override {
+        return nullptr;
+    }
+
+    void SetActiveThread(KThread*) override {}
+
+    std::string received;
+};
+
+u8 Checksum(std::string_view data) {
+    u8 checksum{};
+    for (const char c : data) {
+        checksum = static_cast<u8>(checksum + static_cast<u8>(c));
+    }
+    return checksum;
+}
+
+/// Escapes the bytes the packet framing reserves, as a client does for binary data
+std::string EscapeBinary(std::span<const u8> data) {
+    std::string escaped;
+    escaped.reserve(data.size());
+    for (const u8 byte : data) {
+        if (byte == '#' || byte == '$' || byte == '}' || byte == '*') {
+            escaped += '}';
+            escaped += static_cast<char>(byte ^ 0x20);
+        } else {
+            escaped += static_cast<char>(byte);
+        }
+    }
+    return escaped;
+}
+
+/// Debugs a process whose code region is backed by guest memory, without running it
+class DebugScope final {
+public:
+    DebugScope() {
+        system.Initialize();
+        system.Kernel().Initialize();
+
+        process = KProcess::Create(system.Kernel());
+        KProcess::Register(system.Kernel(), process);
+        REQUIRE(process
+                    ->LoadFromMetadata(FileSys::ProgramMetadata::GetDefault(), CodeSize, 0,
+                                       false)
+                    .IsSuccess());
+        base = GetInteger(process->GetEntryPoint());
+
+        stub = std::make_unique<Core::GDBStub>(backend, system, process);
+        REQUIRE(Request("QStartNoAckMode") == "OK");
+    }
+
+    ~DebugScope() {
+        stub.reset();
+        process->Close();
+        system.Kernel().Shutdown();
+    }
+
+    /// Sends one packet and returns the unescaped body of the reply
+    std::string Request(std::string_view body) {
+        backend.received.clear();
+        const auto packet{fmt::format("${}#{:02x}", body, Checksum(body))};
+        stub->ClientData(std::span{reinterpret_cast<const u8*>(packet.data()), packet.size()});
+
+        // The acknowledgement of the packet enabling no-ack mode is still sent
+        std::string_view reply{backend.received};
+        if (reply.starts_with('+')) {
+            reply.remove_prefix(1);
+        }
+        REQUIRE(reply.size() >= 4);
+        REQUIRE(reply.front() == '$');
+        REQUIRE(reply[reply.size() - 3] == '#');
+
+        const auto escaped{reply.substr(1, reply.size() - 4)};
+        REQUIRE(reply.substr(reply.size() - 2) == fmt::format("{:02x}", Checksum(escaped)));
+
+        std::string unescaped;
+        unescaped.reserve(escaped.size());
+        for (size_t i = 0; i < escaped.size(); i++) {
+            if (escaped[i] == '}' && i + 1 < escaped.size()) {
+                unescaped += static_cast<char>(escaped[++i] ^ 0x20);
+            } else {
+                unescaped += escaped[i];
+            }
+        }
+        return unescaped;
+    }
+
+    VAddr GetBase() const {
+        return base;
+    }
+
+    std::string ReadHex(size_t offset, size_t size) {
+        return Request(fmt::format("m{:x},{:x}", base + offset, size));
+    }
+
+    std::string ReadBinary(size_t offset, size_t size) {
+        return Request(fmt::format("x{:x},{:x}", base + offset, size));
+    }
+
+    std::string WriteHex(size_t offset, std::span<const u8> data) {
+        return Request(
+            fmt::format("M{:x},{:x}:{}", base + offset, data.size(), Common::HexToString(data)));
+    }
+
+    std::string WriteBinary(size_t offset, std::span<const u8> data) {
+        return Request(
+            fmt::format("X{:x},{:x}:{}", base + offset, data.size(), EscapeBinary(data)));
+    }
+
+private:
+    Core::System system;
+    KProcess* process{};
+    VAddr base{};
+    LoopbackBackend backend;
+    std::unique_ptr<Core::GDBStub> stub;
+};
+
+/// Data holding every byte value, including the ones the packet framing escapes
+std::vector<u8> MakePattern(size_t size, u8 seed) {
+    std::vector<u8> data(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = static_cast<u8>(i * 7 + i / 256 + seed);
+    }
+    return data;
+}
+
+std::string AsBinaryReply(std::span<const u8> data) {
+    return "b" + std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+} // Anonymous namespace
+
+TEST_CASE("GDBStub: Memory transfers round trip", "[core]") {
+    DebugScope scope;
+
+    const auto binary{MakePattern(0x1000, 0)};
+    REQUIRE(scope.WriteBinary(0x100, binary) == "OK");
+    REQUIRE(scope.ReadHex(0x100, binary.size()) == Common::HexToString(binary));
+    REQUIRE(scope.ReadBinary(0x100, binary.size()) == AsBinaryReply(binary));
+
+    const auto hex{MakePattern(0x1000, 0x55)};
+    REQUIRE(scope.WriteHex(0x2000, hex) == "OK");
+    REQUIRE(scope.ReadBinary(0x2000, hex.size()) == AsBinaryReply(hex));
+
+    // A transfer spanning both writes sees each of them
+    const auto both{scope.ReadBinary(0x100, 0x2000 + hex.size() - 0x100)};
+    REQUIRE(both.substr(1, binary.size()) == AsBinaryReply(binary).substr(1));
+    REQUIRE(both.substr(1 + 0x1F00) == AsBinaryReply(hex).substr(1));
+}
+
+TEST_CASE("GDBStub: Malformed memory writes are rejected", "[core]") {
+    DebugScope scope;
+
+    const auto data{MakePattern(0x10, 0)};
+    REQUIRE(scope.WriteBinary(0, data) == "OK");
+
+    // Payloads shorter than the requested size leave memory untouched
+    REQUIRE(scope.Request(fmt::format("M{:x},10:0011", scope.GetBase())) == "E01");
+    REQUIRE(scope.ReadBinary(0, data.size()) == AsBinaryReply(data));
+
+    // GDB probes for binary write support with an empty write
+    REQUIRE(scope.Request("X0,0:") == "OK");
+
+    // Addresses outside of the process are errors, not crashes
+    REQUIRE(scope.Request("m0,10") == "E01");
+    REQUIRE(scope.Request("x0,10") == "E01");
+}
+
+TEST_CASE("GDBStub: Memory transfer throughput", "[core][.benchmark]") {
+    DebugScope scope;
+    const auto data{MakePattern(TransferSize, 0)};
+    REQUIRE(scope.WriteBinary(0, data) == "OK");
+
+    // Each request goes through packet parsing, guest memory and reply framing, as a client's
+    // memory dumps do
+    BENCHMARK("64 KiB hex reads") {
+        return scope.ReadHex(0, TransferSize).size();
+    };
+    BENCHMARK("64 KiB binary reads") {
+        return scope.ReadBinary(0, TransferSize).size();
+    };
+    BENCHMARK("64 KiB hex writes") {
+        return scope.WriteHex(0, data).size();
+    };
+    BENCHMARK("64 KiB binary writes") {
+        return scope.WriteBinary(0, data).size();
+    };
+}
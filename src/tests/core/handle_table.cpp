@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/core.h"
+#include "core/hle/kernel/k_event.h"
+#include "core/hle/kernel/k_handle_table.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/kernel.h"
+
+namespace {
+using namespace Kernel;
+
+constexpr size_t NumEmulatedCores = 4;
+constexpr size_t NumHandles = 16;
+
+struct KernelScope final {
+    KernelScope() {
+        system.Initialize();
+        system.Kernel().Initialize();
+    }
+
+    ~KernelScope() {
+        system.Kernel().Shutdown();
+    }
+
+    Core::System system;
+};
+
+Handle AddEvent(KernelCore& kernel, KHandleTable& table) {
+    KEvent* const event = KEvent::Create(kernel);
+    event->Initialize(nullptr);
+    KEvent::Register(kernel, event);
+
+    Handle handle{};
+    REQUIRE(table.Add(&handle, event).IsSuccess());
+
+    // The table holds the only reference from here on.
+    event->Close();
+    return handle;
+}
+} // Anonymous namespace
+
+TEST_CASE("KHandleTable: Lookups race with removals", "[core]") {
+    KernelScope scope;
+    KernelCore& kernel = scope.system.Kernel();
+    KHandleTable table{kernel};
+    REQUIRE(table.Initialize(0).IsSuccess());
+
+    std::array<std::atomic<Handle>, NumHandles> handles;
+    for (auto& handle : handles) {
+        handle = AddEvent(kernel, table);
+    }
+
+    std::atomic<bool> stop{};
+    std::atomic<size_t> found{};
+    std::atomic<size_t> dead_objects{};
+    std::vector<std::jthread> readers;
+    for (size_t core = 0; core < NumEmulatedCores; ++core) {
+        readers.emplace_back([&, core] {
+            size_t index = core;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const Handle handle = handles[index++ % NumHandles].load();
+                const KScopedAutoObject event = table.GetObject<KEvent>(handle);
+                if (event.IsNull()) {
+                    continue;
+                }
+                // A lookup must never hand out an object that was already destroyed.
+                if (event.GetPointerUnsafe()->GetReferenceCount() == 0) {
+                    ++dead_objects;
+                }
+                ++found;
+            }
+        });
+    }
+
+    for (size_t iteration = 0; iteration < 10000; ++iteration) {
+        auto& slot = handles[iteration % NumHandles];
+        const Handle old_handle = slot.load();
+        slot = AddEvent(kernel, table);
+        REQUIRE(table.Remove(old_handle));
+    }
+    stop = true;
+    readers.clear();
+
+    REQUIRE(found > 0);
+    REQUIRE(dead_objects == 0);
+    REQUIRE(table.GetCount() == NumHandles);
+    for (const auto& handle : handles) {
+        REQUIRE(table.Remove(handle.load()));
+        REQUIRE(table.GetObject<KEvent>(handle.load()).IsNull());
+    }
+    REQUIRE(table.Finalize().IsSuccess());
+}
+
+TEST_CASE("KHandleTable: Lookup throughput", "[core][.benchmark]") {
+    KernelScope scope;
+    KernelCore& kernel = scope.system.Kernel();
+    KHandleTable table{kernel};
+    REQUIRE(table.Initialize(0).IsSuccess());
+
+    std::array<Handle, NumHandles> handles;
+    for (auto& handle : handles) {
+        handle = AddEvent(kernel, table);
+    }
+
+    // Every emulated core resolves handles of the same process, as the handle taking SVCs do
+    BENCHMARK("100000 lookups on each of 4 cores") {
+        std::vector<std::jthread> cores;
+        for (size_t core = 0; core < NumEmulatedCores; ++core) {
+            cores.emplace_back([&table, &handles, core] {
+                for (size_t i = 0; i < 100000; ++i) {
+                    const auto event = table.GetObject<KEvent>(handles[(core + i) % NumHandles]);
+                    ASSERT(event.IsNotNull());
+                }
+            });
+        }
+    };
+
+    for (const Handle handle : handles) {
+        table.Remove(handle);
+    }
+    REQUIRE(table.Finalize().IsSuccess());
+}
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "core/file_sys/ips_layer.h"
+#include "core/file_sys/vfs/vfs_vector.h"
+
+namespace {
+using FileSys::CompiledPatch;
+
+constexpr std::size_t ImageSize = 0x100;
+
+std::vector<u8> MakeImage(std::size_t size = ImageSize) {
+    std::vector<u8> image(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        image[i] = static_cast<u8>(i);
+    }
+    return image;
+}
+
+/// Builds an IPS file from the given records, RLE records take their fill byte from data[0]
+FileSys::VirtualFile MakeIPS(const std::vector<CompiledPatch::Record>& records) {
+    std::vector<u8> bytes{'P', 'A', 'T', 'C', 'H'};
+    for (const auto& record : records) {
+        bytes.push_back(static_cast<u8>(record.offset >> 16));
+        bytes.push_back(static_cast<u8>(record.offset >> 8));
+        bytes.push_back(static_cast<u8>(record.offset));
+        const u16 data_size = record.is_rle ? 0 : static_cast<u16>(record.data.size());
+        bytes.push_back(static_cast<u8>(data_size >> 8));
+        bytes.push_back(static_cast<u8>(data_size));
+        if (record.is_rle) {
+            bytes.push_back(static_cast<u8>(record.size >> 8));
+            bytes.push_back(static_cast<u8>(record.size));
+            bytes.push_back(record.data[0]);
+        } else {
+            bytes.insert(bytes.end(), record.data.begin(), record.data.end());
+        }
+    }
+    bytes.insert(bytes.end(), {'E', 'O', 'F'});
+    return std::make_shared<FileSys::VectorVfsFile>(std::move(bytes), "patch.ips");
+}
+
+FileSys::VirtualFile MakeText(const std::string& text) {
+    return std::make_shared<FileSys::VectorVfsFile>(std::vector<u8>(text.begin(), text.end()),
+                                                    "patch.pchtxt");
+}
+
+/// Applies the patches one record at a time, the way they were applied before compilation
+std::vector<u8> ApplyInOrder(std::vector<u8> image,
+                             const std::vector<const CompiledPatch*>& patches) {
+    for (const CompiledPatch* patch : patches) {
+        if (!patch->IsApplicable(image.size())) {
+            continue;
+        }
+        for (const auto& record : patch->records) {
+            if (record.offset >= image.size()) {
+                continue;
+            }
+            const std::size_t size = std::min<std::size_t>(record.size,
+                                                           image.size() - record.offset);
+            for (std::size_t i = 0; i < size; ++i) {
+                image[record.offset + i] = record.is_rle ? record.data[0] : record.data[i];
+            }
+        }
+    }
+    return image;
+}
+} // Anonymous namespace
+
+TEST_CASE("IPS: Later patches win over overlapping earlier ones", "[core]") {
+    const auto ips = FileSys::CompileIPS(MakeIPS({
+        {0x10, 8, {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7}, false},
+        {0x40, 0x10, {0xEE}, true},
+    }));
+    REQUIRE(ips.has_value());
+
+    const FileSys::IPSwitchCompiler text{MakeText("@nsobid-0123456789ABCDEF\n"
+                                                  "@enabled\n"
+                                                  "00000014 B0B1B2B3B4B5\n"
+                                                  "00000048 \"xy\"\n"
+                                                  "@disabled\n"
+                                                  "00000010 FFFFFFFF\n")};
+    REQUIRE(text.IsValid());
+    const CompiledPatch ipswitch = text.Compile();
+    REQUIRE(ipswitch.records.size() == 2);
+
+    std::vector<u8> image = MakeImage();
+    const std::array<const CompiledPatch*, 2> patches{&*ips, &ipswitch};
+    FileSys::ApplyPatches(image, patches);
+
+    const std::vector<u8> expected = ApplyInOrder(MakeImage(), {&*ips, &ipswitch});
+    REQUIRE(image == expected);
+    REQUIRE(image[0x10] == 0xA0);
+    REQUIRE(image[0x14] == 0xB0);
+    REQUIRE(image[0x19] == 0xB5);
+    REQUIRE(image[0x1A] == 0x1A);
+    REQUIRE(image[0x47] == 0xEE);
+    REQUIRE(image[0x48] == 'x');
+    REQUIRE(image[0x49] == 'y');
+    REQUIRE(image[0x4A] == 0xEE);
+    REQUIRE(image[0x50] == 0x50);
+
+    // Reversing the order lets the IPS patch overwrite the IPSwitch one instead
+    image = MakeImage();
+    const std::array<const CompiledPatch*, 2> reversed{&ipswitch, &*ips};
+    FileSys::ApplyPatches(image, reversed);
+    REQUIRE(image == ApplyInOrder(MakeImage(), {&ipswitch, &*ips}));
+    REQUIRE(image[0x14] == 0xA4);
+    REQUIRE(image[0x48] == 0xEE);
+}
+
+TEST_CASE("IPS: Adjacent records are all applied", "[core]") {
+    const CompiledPatch first{.records{{0x20, 2, {0x01, 0x02}, false},
+                                       {0x22, 2, {0x03, 0x04}, false}}};
+    const CompiledPatch second{.records{{0x1E, 2, {0x05}, true}, {0x24, 1, {0x06}, false}}};
+
+    std::vector<u8> image = MakeImage();
+    const std::array<const CompiledPatch*, 2> patches{&first, &second};
+    FileSys::ApplyPatches(image, patches);
+
+    const std::vector<u8> expected{0x05, 0x05, 0x01, 0x02, 0x03, 0x04, 0x06};
+    REQUIRE(std::equal(expected.begin(), expected.end(), image.begin() + 0x1E));
+    REQUIRE(image[0x1D] == 0x1D);
+    REQUIRE(image[0x25] == 0x25);
+}
+
+TEST_CASE("IPS: Out of bounds IPS patches are skipped and IPSwitch records clipped", "[core]") {
+    const auto ips = FileSys::CompileIPS(MakeIPS({
+        {0x08, 2, {0xAA, 0xAA}, false},
+        {ImageSize - 1, 2, {0xBB, 0xBB}, false},
+    }));
+    REQUIRE(ips.has_value());
+    REQUIRE(!ips->IsApplicable(ImageSize));
+
+    const CompiledPatch ipswitch{.records{{ImageSize - 2, 4, {0xC0, 0xC1, 0xC2, 0xC3}, false},
+                                          {ImageSize + 4, 1, {0xC4}, false}}};
+    REQUIRE(ipswitch.IsApplicable(ImageSize));
+
+    std::vector<u8> image = MakeImage();
+    const std::array<const CompiledPatch*, 2> patches{&*ips, &ipswitch};
+    FileSys::ApplyPatches(image, patches);
+
+    REQUIRE(image.size() == ImageSize);
+    REQUIRE(image[0x08] == 0x08);
+    REQUIRE(image[ImageSize - 2] == 0xC0);
+    REQUIRE(image[ImageSize - 1] == 0xC1);
+}
+
+TEST_CASE("IPS: Resolved patches match applying every record in order", "[core]") {
+    std::mt19937 rng{1234};
+    for (std::size_t iteration = 0; iteration < 200; ++iteration) {
+        std::vector<CompiledPatch> patches(1 + rng() % 4);
+        for (auto& patch : patches) {
+            patch.is_strict = rng() % 2 == 0;
+            const std::size_t record_count = rng() % 8;
+            for (std::size_t i = 0; i < record_count; ++i) {
+                const u32 offset = static_cast<u32>(rng() % (ImageSize + 8));
+                const u32 size = static_cast<u32>(rng() % 24);
+                const bool is_rle = rng() % 4 == 0;
+                std::vector<u8> data(is_rle ? 1 : size);
+                for (auto& byte : data) {
+                    byte = static_cast<u8>(rng());
+                }
+                patch.records.push_back({offset, size, std::move(data), is_rle});
+            }
+        }
+
+        std::vector<const CompiledPatch*> patch_list;
+        for (const auto& patch : patches) {
+            patch_list.push_back(&patch);
+        }
+
+        std::vector<u8> image = MakeImage();
+        FileSys::ApplyPatches(image, patch_list);
+        REQUIRE(image == ApplyInOrder(MakeImage(), patch_list));
+    }
+}
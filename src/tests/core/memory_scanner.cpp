@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/common_types.h"
+#include "common/literals.h"
+#include "core/tools/memory_scanner.h"
+
+namespace {
+using namespace Common::Literals;
+using Tools::MemoryScanner;
+
+constexpr VAddr BaseAddress = 0x8000000;
+constexpr u64 PageSize = 4_KiB;
+
+/// Guest memory backed by a host buffer, with an optional unmapped page
+class FakeMemory {
+public:
+    explicit FakeMemory(u64 size, VAddr unmapped_page_ = 0)
+        : data(size), unmapped_page{unmapped_page_} {}
+
+    MemoryScanner::PageLookup GetPageLookup() {
+        return [this](VAddr page_address) -> const u8* {
+            if (page_address < BaseAddress || page_address >= BaseAddress + data.size() ||
+                page_address == unmapped_page) {
+                return nullptr;
+            }
+            return data.data() + (page_address - BaseAddress);
+        };
+    }
+
+    MemoryScanner::Region GetRegion() const {
+        return {BaseAddress, data.size()};
+    }
+
+    template <typename T>
+    void Write(VAddr address, T value) {
+        std::memcpy(data.data() + (address - BaseAddress), &value, sizeof(T));
+    }
+
+private:
+    std::vector<u8> data;
+    VAddr unmapped_page;
+};
+} // Anonymous namespace
+
+TEST_CASE("MemoryScanner: Value scans narrow down candidates", "[core]") {
+    FakeMemory memory{16 * PageSize};
+    MemoryScanner scanner{memory.GetPageLookup()};
+    const std::array regions{memory.GetRegion()};
+
+    memory.Write<u32>(BaseAddress + 0x10, 100);
+    memory.Write<u32>(BaseAddress + 0x2000, 100);
+    memory.Write<u32>(BaseAddress + 0xF004, 100);
+
+    scanner.NewScan(regions, MemoryScanner::ValueType::U32);
+    REQUIRE(scanner.GetCandidateCount() == 16 * PageSize / sizeof(u32));
+
+    scanner.Filter(MemoryScanner::Comparison::Equal, 100);
+    REQUIRE(scanner.GetCandidateCount() == 3);
+
+    memory.Write<u32>(BaseAddress + 0x2000, 90);
+    memory.Write<u32>(BaseAddress + 0xF004, 110);
+    scanner.Filter(MemoryScanner::Comparison::Changed);
+    REQUIRE(scanner.GetCandidateCount() == 2);
+
+    scanner.Filter(MemoryScanner::Comparison::Unchanged);
+    scanner.Filter(MemoryScanner::Comparison::Unchanged);
+    REQUIRE(scanner.GetCandidateCount() == 2);
+
+    memory.Write<u32>(BaseAddress + 0x2000, 80);
+    memory.Write<u32>(BaseAddress + 0xF004, 120);
+    scanner.Filter(MemoryScanner::Comparison::Decreased);
+    const auto candidates = scanner.GetCandidates(16);
+    REQUIRE(candidates.size() == 1);
+    REQUIRE(candidates[0].address == BaseAddress + 0x2000);
+    REQUIRE(candidates[0].value == 80);
+}
+
+TEST_CASE("MemoryScanner: Floating point values are compared as floats", "[core]") {
+    FakeMemory memory{4 * PageSize};
+    MemoryScanner scanner{memory.GetPageLookup()};
+    const std::array regions{memory.GetRegion()};
+
+    memory.Write<f32>(BaseAddress + 0x100, 1.5f);
+    memory.Write<f32>(BaseAddress + 0x200, -2.0f);
+    scanner.NewScan(regions, MemoryScanner::ValueType::F32);
+
+    memory.Write<f32>(BaseAddress + 0x100, 2.5f);
+    memory.Write<f32>(BaseAddress + 0x200, -1.0f);
+    scanner.Filter(MemoryScanner::Comparison::Increased);
+    const auto candidates = scanner.GetCandidates(16);
+    REQUIRE(candidates.size() == 2);
+    REQUIRE(candidates[0].address == BaseAddress + 0x100);
+    REQUIRE(candidates[1].address == BaseAddress + 0x200);
+}
+
+TEST_CASE("MemoryScanner: Unmapped pages have no candidates", "[core]") {
+    FakeMemory memory{4 * PageSize, BaseAddress + PageSize};
+    MemoryScanner scanner{memory.GetPageLookup()};
+    const std::array regions{memory.GetRegion()};
+
+    scanner.NewScan(regions, MemoryScanner::ValueType::U64);
+    REQUIRE(scanner.GetCandidateCount() == 3 * PageSize / sizeof(u64));
+    scanner.Filter(MemoryScanner::Comparison::Equal, 0);
+    REQUIRE(scanner.GetCandidateCount() == 3 * PageSize / sizeof(u64));
+    for (const auto& candidate : scanner.GetCandidates(4 * PageSize)) {
+        REQUIRE((candidate.address < BaseAddress + PageSize ||
+                 candidate.address >= BaseAddress + 2 * PageSize));
+    }
+}
+
+TEST_CASE("MemoryScanner: Patterns are found across chunk boundaries", "[core]") {
+    FakeMemory memory{3_MiB, BaseAddress + 2_MiB};
+    MemoryScanner scanner{memory.GetPageLookup()};
+    const std::array regions{memory.GetRegion()};
+
+    const std::array<u8, 6> pattern{0xDE, 0xAD, 0x00, 0x00, 0xBE, 0xEF};
+    const std::array<u8, 6> mask{0xFF, 0xFF, 0x00, 0x00, 0xFF, 0xFF};
+    const std::array<u8, 6> first{0xDE, 0xAD, 0x12, 0x34, 0xBE, 0xEF};
+    const std::array<u8, 6> second{0xDE, 0xAD, 0x56, 0x78, 0xBE, 0xEF};
+    for (size_t index = 0; index < pattern.size(); ++index) {
+        memory.Write<u8>(BaseAddress + 0x40 + index, first[index]);
+        memory.Write<u8>(BaseAddress + 1_MiB - 3 + index, second[index]);
+        memory.Write<u8>(BaseAddress + 1_MiB + 0x80 + index, first[index] ^ 1);
+    }
+
+    const auto found = scanner.FindPattern(regions, pattern, mask, 16);
+    REQUIRE(found.size() == 2);
+    REQUIRE(found[0] == BaseAddress + 0x40);
+    REQUIRE(found[1] == BaseAddress + 1_MiB - 3);
+
+    REQUIRE(scanner.FindPattern(regions, pattern, mask, 1).size() == 1);
+    REQUIRE(scanner.FindPattern(regions, pattern, {}, 16).empty());
+
+    // Zeroes fill the unmapped page but must not match there
+    const std::array<u8, 8> zeroes{};
+    const auto zero_matches = scanner.FindPattern(regions, zeroes, {}, 3_MiB);
+    for (const VAddr address : zero_matches) {
+        REQUIRE((address + zeroes.size() <= BaseAddress + 2_MiB ||
+                 address >= BaseAddress + 2_MiB + PageSize));
+    }
+}
+
+TEST_CASE("MemoryScanner: Scan throughput", "[core][.benchmark]") {
+    FakeMemory memory{256_MiB};
+    MemoryScanner scanner{memory.GetPageLookup()};
+    const std::array regions{memory.GetRegion()};
+    const std::array<u8, 8> pattern{0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF};
+
+    BENCHMARK("New u32 scan of 256 MiB") {
+        scanner.NewScan(regions, MemoryScanner::ValueType::U32);
+    };
+    BENCHMARK("Unchanged u32 filter of 256 MiB") {
+        scanner.Filter(MemoryScanner::Comparison::Unchanged);
+    };
+    BENCHMARK("Pattern search of 256 MiB") {
+        return scanner.FindPattern(regions, pattern, {}, 16);
+    };
+}
@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/assert.h"
+#include "core/core.h"
+#include "core/hle/service/nvdrv/core/container.h"
+#include "core/hle/service/nvdrv/core/nvmap.h"
+#include "video_core/host1x/host1x.h"
+
+namespace {
+using Service::Nvidia::NvResult;
+using Service::Nvidia::NvCore::NvMap;
+
+constexpr size_t NumThreads = 4;
+constexpr size_t HandlesPerThread = 1000;
+
+struct NvMapScope final {
+    NvMapScope() {
+        system.Initialize();
+        host1x = std::make_unique<Tegra::Host1x::Host1x>(system);
+        container = std::make_unique<Service::Nvidia::NvCore::Container>(*host1x);
+    }
+
+    NvMap& GetNvMap() {
+        return container->GetNvMapFile();
+    }
+
+    Core::System system;
+    std::unique_ptr<Tegra::Host1x::Host1x> host1x;
+    std::unique_ptr<Service::Nvidia::NvCore::Container> container;
+};
+
+NvMap::Handle::Id CreateHandle(NvMap& nvmap) {
+    std::shared_ptr<NvMap::Handle> handle;
+    REQUIRE(nvmap.CreateHandle(0x1000, handle) == NvResult::Success);
+    return handle->id;
+}
+} // Anonymous namespace
+
+TEST_CASE("NvMap: Concurrently created handles are unique", "[core]") {
+    NvMapScope scope;
+    NvMap& nvmap = scope.GetNvMap();
+
+    std::array<std::vector<NvMap::Handle::Id>, NumThreads> ids;
+    {
+        std::vector<std::jthread> threads;
+        for (size_t thread = 0; thread < NumThreads; ++thread) {
+            threads.emplace_back([&nvmap, &thread_ids = ids[thread]] {
+                for (size_t i = 0; i < HandlesPerThread; ++i) {
+                    std::shared_ptr<NvMap::Handle> handle;
+                    if (nvmap.CreateHandle(0x1000, handle) == NvResult::Success) {
+                        thread_ids.push_back(handle->id);
+                    }
+                }
+            });
+        }
+    }
+
+    std::vector<NvMap::Handle::Id> all_ids;
+    for (const auto& thread_ids : ids) {
+        REQUIRE(thread_ids.size() == HandlesPerThread);
+        all_ids.insert(all_ids.end(), thread_ids.begin(), thread_ids.end());
+    }
+    std::ranges::sort(all_ids);
+    REQUIRE(std::ranges::adjacent_find(all_ids) == all_ids.end());
+    for (const NvMap::Handle::Id id : all_ids) {
+        REQUIRE(id != 0);
+        REQUIRE(id % 4 == 0);
+        REQUIRE(nvmap.GetHandle(id)->id == id);
+    }
+}
+
+TEST_CASE("NvMap: Freed handle IDs stay invalid after their slot is reused", "[core]") {
+    NvMapScope scope;
+    NvMap& nvmap = scope.GetNvMap();
+
+    std::vector<NvMap::Handle::Id> freed_ids;
+    for (size_t i = 0; i < 64; ++i) {
+        const NvMap::Handle::Id id = CreateHandle(nvmap);
+        REQUIRE(nvmap.FreeHandle(id, false).has_value());
+        REQUIRE(nvmap.GetHandle(id) == nullptr);
+        freed_ids.push_back(id);
+    }
+
+    // Every slot has been released at least once, new handles reuse them under a new generation
+    std::vector<NvMap::Handle::Id> live_ids;
+    for (size_t i = 0; i < 64; ++i) {
+        live_ids.push_back(CreateHandle(nvmap));
+    }
+    for (const NvMap::Handle::Id id : freed_ids) {
+        REQUIRE(nvmap.GetHandle(id) == nullptr);
+        REQUIRE(!nvmap.FreeHandle(id, false).has_value());
+    }
+    for (const NvMap::Handle::Id id : live_ids) {
+        REQUIRE(nvmap.GetHandle(id) != nullptr);
+    }
+    REQUIRE(nvmap.GetHandle(2) == nullptr);
+}
+
+TEST_CASE("NvMap: Handle IDs are not reissued once a slot runs out of generations", "[core]") {
+    NvMapScope scope;
+    NvMap& nvmap = scope.GetNvMap();
+
+    // Churns every shard through more than the 1024 generations a slot can hold
+    std::vector<NvMap::Handle::Id> ids;
+    for (size_t i = 0; i < 16 * 1024 * 2; ++i) {
+        const NvMap::Handle::Id id = CreateHandle(nvmap);
+        REQUIRE(nvmap.FreeHandle(id, false).has_value());
+        ids.push_back(id);
+    }
+
+    std::ranges::sort(ids);
+    REQUIRE(std::ranges::adjacent_find(ids) == ids.end());
+    for (const NvMap::Handle::Id id : ids) {
+        REQUIRE(nvmap.GetHandle(id) == nullptr);
+    }
+}
+
+TEST_CASE("NvMap: Handle lookup contention", "[core][.benchmark]") {
+    NvMapScope scope;
+    NvMap& nvmap = scope.GetNvMap();
+
+    std::array<NvMap::Handle::Id, 64> ids;
+    for (auto& id : ids) {
+        id = CreateHandle(nvmap);
+    }
+
+    // Mirrors the nvhost ioctls of several submission threads resolving handles concurrently
+    // while another thread keeps allocating and freeing
+    BENCHMARK("100000 lookups on each of 4 threads with concurrent churn") {
+        std::vector<std::jthread> threads;
+        threads.emplace_back([&nvmap] {
+            for (size_t i = 0; i < 10000; ++i) {
+                std::shared_ptr<NvMap::Handle> handle;
+                if (nvmap.CreateHandle(0x1000, handle) == NvResult::Success) {
+                    nvmap.FreeHandle(handle->id, false);
+                }
+            }
+        });
+        for (size_t thread = 0; thread < NumThreads; ++thread) {
+            threads.emplace_back([&nvmap, &ids, thread] {
+                for (size_t i = 0; i < 100000; ++i) {
+                    const auto handle = nvmap.GetHandle(ids[(thread + i) % ids.size()]);
+                    ASSERT(handle != nullptr);
+                }
+            });
+        }
+    };
+}
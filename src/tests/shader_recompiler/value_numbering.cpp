@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "shader_recompiler/frontend/ir/basic_block.h"
+#include "shader_recompiler/frontend/ir/ir_emitter.h"
+#include "shader_recompiler/frontend/ir/post_order.h"
+#include "shader_recompiler/frontend/ir/program.h"
+#include "shader_recompiler/ir_opt/passes.h"
+#include "shader_recompiler/object_pool.h"
+
+namespace {
+using namespace Shader;
+
+class ProgramBuilder {
+public:
+    IR::Block* NewBlock() {
+        return block_pool.Create(inst_pool);
+    }
+
+    void AddBlock(IR::Block* block) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = IR::AbstractSyntaxNode::Type::Block;
+        node.data.block = block;
+        program.blocks.push_back(block);
+    }
+
+    void AddLoop(IR::Block* body, IR::Block* continue_block, IR::Block* merge) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = IR::AbstractSyntaxNode::Type::Loop;
+        node.data.loop.body = body;
+        node.data.loop.continue_block = continue_block;
+        node.data.loop.merge = merge;
+    }
+
+    void AddRepeat(IR::Block* header, IR::Block* merge) {
+        auto& node{program.syntax_list.emplace_back()};
+        node.type = IR::AbstractSyntaxNode::Type::Repeat;
+        node.data.repeat.cond = IR::U1{IR::Value{true}};
+        node.data.repeat.loop_header = header;
+        node.data.repeat.merge = merge;
+    }
+
+    IR::Program& Finish() {
+        program.syntax_list.emplace_back().type = IR::AbstractSyntaxNode::Type::Return;
+        program.post_order_blocks = IR::PostOrder(program.syntax_list.front());
+        return program;
+    }
+
+private:
+    ObjectPool<IR::Inst> inst_pool;
+    ObjectPool<IR::Block> block_pool;
+    IR::Program program;
+};
+
+size_t CountOpcode(const IR::Program& program, IR::Opcode opcode) {
+    size_t count{};
+    for (const IR::Block* const block : program.blocks) {
+        count += std::ranges::count_if(block->Instructions(), [opcode](const IR::Inst& inst) {
+            return inst.GetOpcode() == opcode;
+        });
+    }
+    return count;
+}
+
+bool Contains(const IR::Block* block, const IR::Inst* inst) {
+    return std::ranges::any_of(block->Instructions(),
+                               [inst](const IR::Inst& block_inst) { return &block_inst == inst; });
+}
+} // Anonymous namespace
+
+TEST_CASE("GlobalValueNumbering: Redundant values are merged", "[shader_recompiler]") {
+    ProgramBuilder builder;
+    IR::Block* const block{builder.NewBlock()};
+    builder.AddBlock(block);
+
+    IR::IREmitter ir{*block};
+    const IR::U64 address{ir.Imm64(u64{0x1000})};
+    const IR::U32 cbuf_a{ir.GetCbuf(ir.Imm32(0), ir.Imm32(16))};
+    const IR::U32 cbuf_b{ir.GetCbuf(ir.Imm32(0), ir.Imm32(16))};
+    const IR::U32 sum_a{ir.IAdd(cbuf_a, ir.Imm32(4))};
+    const IR::U32 sum_b{ir.IAdd(ir.Imm32(4), cbuf_b)};
+    ir.WriteGlobal32(address, sum_a);
+    ir.WriteGlobal32(address, sum_b);
+
+    IR::Program& program{builder.Finish()};
+    Optimization::GlobalValueNumberingPass(program);
+    Optimization::DeadCodeEliminationPass(program);
+
+    REQUIRE(CountOpcode(program, IR::Opcode::GetCbufU32) == 1);
+    REQUIRE(CountOpcode(program, IR::Opcode::IAdd32) == 1);
+    REQUIRE(sum_a.Resolve() == sum_b.Resolve());
+    REQUIRE(CountOpcode(program, IR::Opcode::WriteGlobal32) == 2);
+}
+
+TEST_CASE("GlobalValueNumbering: Memory reads are not merged", "[shader_recompiler]") {
+    ProgramBuilder builder;
+    IR::Block* const block{builder.NewBlock()};
+    builder.AddBlock(block);
+
+    IR::IREmitter ir{*block};
+    const IR::U64 address{ir.Imm64(u64{0x1000})};
+    const IR::U32 load_a{ir.LoadGlobal32(address)};
+    ir.WriteGlobal32(address, ir.Imm32(1));
+    const IR::U32 load_b{ir.LoadGlobal32(address)};
+    ir.WriteGlobal32(address, ir.IAdd(load_a, load_b));
+
+    IR::Program& program{builder.Finish()};
+    Optimization::GlobalValueNumberingPass(program);
+    Optimization::DeadCodeEliminationPass(program);
+
+    REQUIRE(CountOpcode(program, IR::Opcode::LoadGlobal32) == 2);
+    REQUIRE(load_a.Resolve() != load_b.Resolve());
+}
+
+TEST_CASE("GlobalValueNumbering: Only dominating values are reused", "[shader_recompiler]") {
+    ProgramBuilder builder;
+    IR::Block* const entry{builder.NewBlock()};
+    IR::Block* const then_block{builder.NewBlock()};
+    IR::Block* const merge{builder.NewBlock()};
+    entry->AddBranch(then_block);
+    entry->AddBranch(merge);
+    then_block->AddBranch(merge);
+    builder.AddBlock(entry);
+    builder.AddBlock(then_block);
+    builder.AddBlock(merge);
+
+    IR::IREmitter entry_ir{*entry};
+    const IR::U64 address{entry_ir.Imm64(u64{0x1000})};
+    const IR::U32 value{entry_ir.LoadGlobal32(address)};
+
+    // Computed in the conditional block first, it does not dominate the merge block
+    IR::IREmitter then_ir{*then_block};
+    const IR::U32 then_product{then_ir.IMul(value, then_ir.Imm32(3))};
+    then_ir.WriteGlobal32(address, then_product);
+
+    IR::IREmitter merge_ir{*merge};
+    const IR::U32 merge_product{merge_ir.IMul(value, merge_ir.Imm32(3))};
+    merge_ir.WriteGlobal32(address, merge_product);
+    const IR::U32 merge_product_again{merge_ir.IMul(merge_ir.Imm32(3), value)};
+    merge_ir.WriteGlobal32(address, merge_product_again);
+
+    IR::Program& program{builder.Finish()};
+    Optimization::GlobalValueNumberingPass(program);
+    Optimization::DeadCodeEliminationPass(program);
+
+    REQUIRE(CountOpcode(program, IR::Opcode::IMul32) == 2);
+    REQUIRE(then_product.Resolve() != merge_product.Resolve());
+    REQUIRE(merge_product.Resolve() == merge_product_again.Resolve());
+}
+
+TEST_CASE("LoopInvariantCodeMotion: Invariant values are hoisted", "[shader_recompiler]") {
+    ProgramBuilder builder;
+    IR::Block* const preheader{builder.NewBlock()};
+    IR::Block* const header{builder.NewBlock()};
+    IR::Block* const body{builder.NewBlock()};
+    IR::Block* const continue_block{builder.NewBlock()};
+    IR::Block* const merge{builder.NewBlock()};
+    preheader->AddBranch(header);
+    header->AddBranch(body);
+    body->AddBranch(continue_block);
+    continue_block->AddBranch(header);
+    continue_block->AddBranch(merge);
+
+    builder.AddBlock(preheader);
+    builder.AddBlock(header);
+    builder.AddLoop(body, continue_block, merge);
+    builder.AddBlock(body);
+    builder.AddBlock(continue_block);
+    builder.AddRepeat(header, merge);
+    builder.AddBlock(merge);
+
+    IR::IREmitter preheader_ir{*preheader};
+    const IR::U64 address{preheader_ir.Imm64(u64{0x1000})};
+    const IR::U32 cbuf{preheader_ir.GetCbuf(preheader_ir.Imm32(0), preheader_ir.Imm32(16))};
+
+    IR::IREmitter body_ir{*body};
+    const IR::U32 scale{body_ir.IMul(cbuf, body_ir.Imm32(3))};
+    const IR::U32 offset{body_ir.IAdd(scale, body_ir.Imm32(8))};
+    const IR::U32 load{body_ir.LoadGlobal32(address)};
+    const IR::U32 result{body_ir.IAdd(load, offset)};
+    body_ir.WriteGlobal32(address, result);
+
+    IR::Program& program{builder.Finish()};
+    Optimization::LoopInvariantCodeMotionPass(program);
+
+    REQUIRE(Contains(preheader, scale.Inst()));
+    REQUIRE(Contains(preheader, offset.Inst()));
+    REQUIRE(Contains(body, load.Inst()));
+    REQUIRE(Contains(body, result.Inst()));
+}
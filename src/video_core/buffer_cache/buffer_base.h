@@ -115,12 +115,23 @@ public:
         return size_bytes;
     }
 
+    /// Returns a value that changes whenever the buffer contents are modified
+    [[nodiscard]] u64 Generation() const noexcept {
+        return generation;
+    }
+
+    /// Sets the generation, invalidating host data derived from the buffer contents
+    void SetGeneration(u64 generation_) noexcept {
+        generation = generation_;
+    }
+
 private:
     VAddr cpu_addr = 0;
     BufferFlagBits flags{};
     int stream_score = 0;
     size_t lru_id = SIZE_MAX;
     size_t size_bytes = 0;
+    u64 generation = 0;
 };
 
 } // namespace VideoCommon
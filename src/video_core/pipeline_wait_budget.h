@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/common_types.h"
+#include "common/logging/log.h"
+#include "common/settings.h"
+
+namespace VideoCommon {
+
+/// Decides what to do with draws whose pipeline is still being built asynchronously, limiting
+/// the time spent blocked on pipeline builds to a per-frame budget.
+class PipelineWaitBudget {
+public:
+    explicit PipelineWaitBudget()
+        : mode{Settings::values.async_shader_mode.GetValue()},
+          budget{std::chrono::milliseconds{Settings::values.async_shader_wait_budget.GetValue()}},
+          remaining{budget} {}
+
+    ~PipelineWaitBudget() {
+        LOG_DEBUG(Render,
+                  "Pipeline builds: {} draws waited ({} ms in budget), {} skipped over {} frames",
+                  statistics.waited_draws,
+                  std::chrono::duration_cast<std::chrono::milliseconds>(statistics.wait_time)
+                      .count(),
+                  statistics.skipped_draws, statistics.frames_with_skips);
+    }
+
+    /// Returns true when the draw should use the pipeline, false when it has to be skipped.
+    /// wait_for is called with the remaining budget and returns true if the build finished.
+    template <typename WaitFunc>
+    [[nodiscard]] bool Acquire(WaitFunc&& wait_for) {
+        switch (mode) {
+        case Settings::AsyncShaderMode::Wait:
+            ++statistics.waited_draws;
+            return true;
+        case Settings::AsyncShaderMode::Budgeted:
+            if (remaining > std::chrono::nanoseconds::zero()) {
+                const auto start = std::chrono::steady_clock::now();
+                const bool is_built = wait_for(remaining);
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                remaining -= std::min<std::chrono::nanoseconds>(elapsed, remaining);
+                statistics.wait_time += elapsed;
+                if (is_built) {
+                    ++statistics.waited_draws;
+                    return true;
+                }
+            }
+            break;
+        case Settings::AsyncShaderMode::Skip:
+            break;
+        }
+        ++statistics.skipped_draws;
+        skipped_this_frame = true;
+        return false;
+    }
+
+    /// Refills the budget, must be called once per guest frame
+    void NextFrame() noexcept {
+        if (skipped_this_frame) {
+            ++statistics.frames_with_skips;
+        }
+        skipped_this_frame = false;
+        remaining = budget;
+    }
+
+private:
+    struct Statistics {
+        u64 waited_draws{};                   ///< Draws that waited for their pipeline build
+        u64 skipped_draws{};                  ///< Draws skipped instead of stalling
+        u64 frames_with_skips{};              ///< Frames with at least one skipped draw
+        std::chrono::nanoseconds wait_time{}; ///< Time spent waiting inside the budget
+    };
+
+    Settings::AsyncShaderMode mode;
+    std::chrono::nanoseconds budget;
+    std::chrono::nanoseconds remaining;
+    bool skipped_this_frame{};
+    Statistics statistics;
+};
+
+} // namespace VideoCommon
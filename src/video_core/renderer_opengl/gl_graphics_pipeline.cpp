@@ -259,7 +259,7 @@ GraphicsPipeline::GraphicsPipeline(const Device& device, TextureCache& texture_c
             built_fence.Create();
             // Flush this context to ensure compilation commands and fence are in the GPU pipe.
             glFlush();
-            built_condvar.notify_one();
+            built_condvar.notify_all();
         } else {
             is_built = true;
         }
@@ -623,6 +623,26 @@ void GraphicsPipeline::WaitForBuild() {
     is_built = true;
 }
 
+bool GraphicsPipeline::WaitForBuild(std::chrono::nanoseconds timeout) {
+    if (is_built) {
+        return true;
+    }
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    if (built_fence.handle == 0) {
+        std::unique_lock lock{built_mutex};
+        if (!built_condvar.wait_until(lock, deadline,
+                                      [this] { return built_fence.handle != 0; })) {
+            return false;
+        }
+    }
+    const auto remaining = std::max<std::chrono::nanoseconds>(
+        deadline - std::chrono::steady_clock::now(), std::chrono::nanoseconds::zero());
+    const GLenum result = glClientWaitSync(built_fence.handle, 0,
+                                           static_cast<GLuint64>(remaining.count()));
+    is_built = result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+    return is_built;
+}
+
 bool GraphicsPipeline::IsBuilt() noexcept {
     if (is_built) {
         return true;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <type_traits>
 #include <utility>
@@ -104,6 +105,9 @@ public:
 
     [[nodiscard]] bool IsBuilt() noexcept;
 
+    /// Waits up to the given timeout for the pipeline to be built, returns true when it is
+    [[nodiscard]] bool WaitForBuild(std::chrono::nanoseconds timeout);
+
     template <typename Spec>
     static auto MakeConfigureSpecFunc() {
         return [](GraphicsPipeline* pipeline, bool is_indexed) {
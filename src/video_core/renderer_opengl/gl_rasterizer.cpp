@@ -724,6 +724,7 @@ void RasterizerOpenGL::TickFrame() {
     // Ticking a frame means that buffers will be swapped, calling glFlush implicitly.
     num_queued_commands = 0;
 
+    shader_cache.TickFrame();
     fence_manager.TickFrame();
     {
         std::scoped_lock lock{texture_cache.mutex};
@@ -398,16 +398,22 @@ GraphicsPipeline* ShaderCache::CurrentGraphicsPipelineSlowPath() {
     return BuiltPipeline(current_pipeline);
 }
 
-GraphicsPipeline* ShaderCache::BuiltPipeline(GraphicsPipeline* pipeline) const noexcept {
+GraphicsPipeline* ShaderCache::BuiltPipeline(GraphicsPipeline* pipeline) {
     if (pipeline->IsBuilt()) {
         return pipeline;
     }
     if (!use_asynchronous_shaders) {
         return pipeline;
     }
-    // When asynchronous shaders are enabled, avoid blocking the main thread completely.
-    // Skip the draw until the pipeline is ready to prevent stutter.
-    return nullptr;
+    // When asynchronous shaders are enabled, only block within the per-frame budget.
+    // Otherwise skip the draw until the pipeline is ready to prevent stutter.
+    const bool use_pipeline = pipeline_wait_budget.Acquire(
+        [pipeline](std::chrono::nanoseconds timeout) { return pipeline->WaitForBuild(timeout); });
+    return use_pipeline ? pipeline : nullptr;
+}
+
+void ShaderCache::TickFrame() {
+    pipeline_wait_budget.NextFrame();
 }
 
 ComputePipeline* ShaderCache::CurrentComputePipeline() {
@@ -12,6 +12,7 @@
 #include "shader_recompiler/profile.h"
 #include "video_core/renderer_opengl/gl_compute_pipeline.h"
 #include "video_core/renderer_opengl/gl_graphics_pipeline.h"
+#include "video_core/pipeline_wait_budget.h"
 #include "video_core/renderer_opengl/gl_shader_context.h"
 #include "video_core/shader_cache.h"
 
@@ -42,10 +43,13 @@ public:
 
     [[nodiscard]] ComputePipeline* CurrentComputePipeline();
 
+    /// Refills the per-frame budget for waiting on asynchronously built pipelines
+    void TickFrame();
+
 private:
     GraphicsPipeline* CurrentGraphicsPipelineSlowPath();
 
-    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) const noexcept;
+    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline);
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
@@ -73,6 +77,7 @@ private:
     VideoCore::ShaderNotify& shader_notify;
     const bool use_asynchronous_shaders;
     const bool strict_context_required;
+    VideoCommon::PipelineWaitBudget pipeline_wait_budget;
 
     GraphicsPipelineKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
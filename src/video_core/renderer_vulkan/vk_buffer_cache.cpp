@@ -7,9 +7,12 @@
 #include <span>
 #include <vector>
 
+#include <boost/functional/hash.hpp>
+
 #include "common/alignment.h"
 #include "common/literals.h"
 #include "common/common_types.h"
+#include "common/logging/log.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 
 #include "video_core/renderer_vulkan/maxwell_to_vk.h"
@@ -24,6 +27,11 @@ using namespace Common::Literals;
 
 namespace Vulkan {
 namespace {
+// Frames an unused translated index buffer is kept alive
+constexpr u64 TRANSLATED_INDEX_BUFFER_LIFETIME = 300;
+// Frames between scans for stale translated index buffers
+constexpr u64 TRANSLATED_INDEX_BUFFER_EVICT_PERIOD = 60;
+
 VkBufferCopy MakeBufferCopy(const VideoCommon::BufferCopy& copy) {
     return VkBufferCopy{
         .srcOffset = copy.src_offset,
@@ -404,6 +412,12 @@ BufferCacheRuntime::BufferCacheRuntime(const Device& device_, MemoryAllocator& m
                                                                      scheduler_, staging_pool_);
 }
 
+BufferCacheRuntime::~BufferCacheRuntime() {
+    LOG_DEBUG(Render_Vulkan, "Translated index buffers: {} hits, {} misses, {} stored",
+              index_cache_statistics.hits, index_cache_statistics.misses,
+              index_cache_statistics.persistent);
+}
+
 StagingBufferRef BufferCacheRuntime::UploadStagingBuffer(size_t size) {
     return staging_pool.Request(size, MemoryUsage::Upload);
 }
@@ -436,10 +450,14 @@ void BufferCacheRuntime::TickFrame(Common::SlotVector<Buffer>& slot_buffers) noe
     for (auto it = slot_buffers.begin(); it != slot_buffers.end(); it++) {
         it->ResetUsageTracking();
     }
+    ++frame_count;
+    if (frame_count % TRANSLATED_INDEX_BUFFER_EVICT_PERIOD == 0) {
+        EvictTranslatedIndexBuffers();
+    }
 }
 
 void BufferCacheRuntime::Finish() {
-    scheduler.Finish();
+    staging_pool.FinishReadback();
 }
 
 bool BufferCacheRuntime::CanReorderUpload(const Buffer& buffer,
@@ -555,19 +573,19 @@ void BufferCacheRuntime::ClearBuffer(VkBuffer dest_buffer, u32 offset, size_t si
 
 void BufferCacheRuntime::BindIndexBuffer(PrimitiveTopology topology, IndexFormat index_format,
                                          u32 base_vertex, u32 num_indices, VkBuffer buffer,
-                                         u32 offset, [[maybe_unused]] u32 size) {
+                                         u32 offset, [[maybe_unused]] u32 size, u64 generation) {
     VkIndexType vk_index_type = MaxwellToVK::IndexFormat(index_format);
     VkDeviceSize vk_offset = offset;
     VkBuffer vk_buffer = buffer;
     if (topology == PrimitiveTopology::Quads || topology == PrimitiveTopology::QuadStrip) {
         vk_index_type = VK_INDEX_TYPE_UINT32;
-        std::tie(vk_buffer, vk_offset) =
-            quad_index_pass.Assemble(index_format, num_indices, base_vertex, buffer, offset,
-                                     topology == PrimitiveTopology::QuadStrip);
+        std::tie(vk_buffer, vk_offset) = TranslateIndexBuffer(
+            topology, index_format, base_vertex, num_indices, buffer, offset, generation);
     } else if (vk_index_type == VK_INDEX_TYPE_UINT8_EXT && !device.IsExtIndexTypeUint8Supported()) {
         vk_index_type = VK_INDEX_TYPE_UINT16;
         if (uint8_pass) {
-            std::tie(vk_buffer, vk_offset) = uint8_pass->Assemble(num_indices, buffer, offset);
+            std::tie(vk_buffer, vk_offset) = TranslateIndexBuffer(
+                topology, index_format, base_vertex, num_indices, buffer, offset, generation);
         }
     }
     if (vk_buffer == VK_NULL_HANDLE) {
@@ -580,6 +598,84 @@ void BufferCacheRuntime::BindIndexBuffer(PrimitiveTopology topology, IndexFormat
     });
 }
 
+size_t BufferCacheRuntime::TranslatedIndexKeyHash::operator()(
+    const TranslatedIndexKey& key) const noexcept {
+    size_t seed = std::hash<VkBuffer>()(key.buffer);
+    boost::hash_combine(seed, key.offset);
+    boost::hash_combine(seed, key.first);
+    boost::hash_combine(seed, key.count);
+    boost::hash_combine(seed, static_cast<u32>(key.format));
+    boost::hash_combine(seed, static_cast<u32>(key.topology));
+    return seed;
+}
+
+std::pair<VkBuffer, VkDeviceSize> BufferCacheRuntime::TranslateIndexBuffer(
+    PrimitiveTopology topology, IndexFormat index_format, u32 first, u32 count, VkBuffer buffer,
+    u32 offset, u64 generation) {
+    const bool is_quad =
+        topology == PrimitiveTopology::Quads || topology == PrimitiveTopology::QuadStrip;
+    const u32 num_quads = topology == PrimitiveTopology::QuadStrip
+                              ? (count >= 2 ? (count - 2) / 2 : 0)
+                              : count / 4;
+    const size_t translated_size = is_quad ? num_quads * 6 * sizeof(u32) : count * sizeof(u16);
+    if (buffer == VK_NULL_HANDLE || translated_size == 0) {
+        return AssembleIndices(topology, index_format, first, count, buffer, offset, nullptr);
+    }
+    const TranslatedIndexKey key{
+        .buffer = buffer,
+        .offset = offset,
+        .first = first,
+        .count = count,
+        .format = index_format,
+        .topology = topology,
+    };
+    const auto [it, is_new] = translated_index_buffers.try_emplace(key);
+    TranslatedIndexBuffer& entry = it->second;
+    entry.last_frame = frame_count;
+    if (!is_new && entry.generation == generation) {
+        if (entry.staging) {
+            ++index_cache_statistics.hits;
+            return {entry.staging->buffer, entry.staging->offset};
+        }
+        // Same contents seen twice, keep a persistent translation for the next draws
+        ++index_cache_statistics.misses;
+        ++index_cache_statistics.persistent;
+        entry.staging = staging_pool.Request(translated_size, MemoryUsage::DeviceLocal, true);
+        return AssembleIndices(topology, index_format, first, count, buffer, offset,
+                               &*entry.staging);
+    }
+    ++index_cache_statistics.misses;
+    if (entry.staging) {
+        staging_pool.FreeDeferred(*entry.staging);
+        entry.staging.reset();
+    }
+    entry.generation = generation;
+    return AssembleIndices(topology, index_format, first, count, buffer, offset, nullptr);
+}
+
+std::pair<VkBuffer, VkDeviceSize> BufferCacheRuntime::AssembleIndices(
+    PrimitiveTopology topology, IndexFormat index_format, u32 first, u32 count, VkBuffer buffer,
+    u32 offset, const StagingBufferRef* dst) {
+    if (topology == PrimitiveTopology::Quads || topology == PrimitiveTopology::QuadStrip) {
+        return quad_index_pass.Assemble(index_format, count, first, buffer, offset,
+                                        topology == PrimitiveTopology::QuadStrip, dst);
+    }
+    return uint8_pass->Assemble(count, buffer, offset, dst);
+}
+
+void BufferCacheRuntime::EvictTranslatedIndexBuffers() {
+    std::erase_if(translated_index_buffers, [this](auto& pair) {
+        TranslatedIndexBuffer& entry = pair.second;
+        if (entry.last_frame + TRANSLATED_INDEX_BUFFER_LIFETIME > frame_count) {
+            return false;
+        }
+        if (entry.staging) {
+            staging_pool.FreeDeferred(*entry.staging);
+        }
+        return true;
+    });
+}
+
 void BufferCacheRuntime::BindQuadIndexBuffer(PrimitiveTopology topology, u32 first, u32 count) {
     if (count == 0) {
         ReserveNullBuffer();
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
 #include "video_core/buffer_cache/buffer_cache_base.h"
 #include "video_core/buffer_cache/memory_tracker_base.h"
 #include "video_core/buffer_cache/usage_tracker.h"
@@ -80,6 +84,7 @@ public:
                                 GuestDescriptorQueue& guest_descriptor_queue,
                                 ComputePassDescriptorQueue& compute_pass_descriptor_queue,
                                 DescriptorPool& descriptor_pool);
+    ~BufferCacheRuntime();
 
     void TickFrame(Common::SlotVector<Buffer>& slot_buffers) noexcept;
 
@@ -114,7 +119,7 @@ public:
     void ClearBuffer(VkBuffer dest_buffer, u32 offset, size_t size, u32 value);
 
     void BindIndexBuffer(PrimitiveTopology topology, IndexFormat index_format, u32 num_indices,
-                         u32 base_vertex, VkBuffer buffer, u32 offset, u32 size);
+                         u32 base_vertex, VkBuffer buffer, u32 offset, u32 size, u64 generation);
 
     void BindQuadIndexBuffer(PrimitiveTopology topology, u32 first, u32 count);
 
@@ -148,10 +153,50 @@ public:
     }
 
 private:
+    /// Counters for the translated (quad and uint8) index buffer cache
+    struct IndexCacheStatistics {
+        u64 hits{};       ///< Draws that reused a translated index buffer
+        u64 misses{};     ///< Draws that had to translate their indices
+        u64 persistent{}; ///< Translations stored for reuse
+    };
+
+    struct TranslatedIndexKey {
+        VkBuffer buffer;
+        u32 offset;
+        u32 first;
+        u32 count;
+        IndexFormat format;
+        PrimitiveTopology topology;
+
+        bool operator==(const TranslatedIndexKey&) const noexcept = default;
+    };
+
+    struct TranslatedIndexKeyHash {
+        size_t operator()(const TranslatedIndexKey& key) const noexcept;
+    };
+
+    struct TranslatedIndexBuffer {
+        u64 generation{};
+        u64 last_frame{};
+        std::optional<StagingBufferRef> staging;
+    };
+
     void BindBuffer(VkBuffer buffer, u32 offset, u32 size) {
         guest_descriptor_queue.AddBuffer(buffer, offset, size);
     }
 
+    std::pair<VkBuffer, VkDeviceSize> TranslateIndexBuffer(PrimitiveTopology topology,
+                                                           IndexFormat index_format, u32 first,
+                                                           u32 count, VkBuffer buffer, u32 offset,
+                                                           u64 generation);
+
+    std::pair<VkBuffer, VkDeviceSize> AssembleIndices(PrimitiveTopology topology,
+                                                      IndexFormat index_format, u32 first,
+                                                      u32 count, VkBuffer buffer, u32 offset,
+                                                      const StagingBufferRef* dst);
+
+    void EvictTranslatedIndexBuffers();
+
     void ReserveNullBuffer();
     vk::Buffer CreateNullBuffer();
 
@@ -168,6 +213,11 @@ private:
 
     std::unique_ptr<Uint8Pass> uint8_pass;
     QuadIndexedPass quad_index_pass;
+
+    std::unordered_map<TranslatedIndexKey, TranslatedIndexBuffer, TranslatedIndexKeyHash>
+        translated_index_buffers;
+    IndexCacheStatistics index_cache_statistics;
+    u64 frame_count = 0;
 };
 
 struct BufferCacheParams {
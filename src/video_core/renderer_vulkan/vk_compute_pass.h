@@ -57,9 +57,11 @@ public:
     ~Uint8Pass();
 
     /// Assemble uint8 indices into an uint16 index buffer
+    /// When dst is provided, the indices are written there instead of a transient staging buffer
     /// Returns a pair with the staging buffer, and the offset where the assembled data is
     std::pair<VkBuffer, VkDeviceSize> Assemble(u32 num_vertices, VkBuffer src_buffer,
-                                               u32 src_offset);
+                                               u32 src_offset,
+                                               const StagingBufferRef* dst = nullptr);
 
 private:
     Scheduler& scheduler;
@@ -77,7 +79,8 @@ public:
 
     std::pair<VkBuffer, VkDeviceSize> Assemble(
         Tegra::Engines::Maxwell3D::Regs::IndexFormat index_format, u32 num_vertices,
-        u32 base_vertex, VkBuffer src_buffer, u32 src_offset, bool is_strip);
+        u32 base_vertex, VkBuffer src_buffer, u32 src_offset, bool is_strip,
+        const StagingBufferRef* dst = nullptr);
 
 private:
     Scheduler& scheduler;
@@ -280,7 +280,7 @@ GraphicsPipeline::GraphicsPipeline(
 
         std::scoped_lock lock{build_mutex};
         is_built = true;
-        build_condvar.notify_one();
+        build_condvar.notify_all();
         if (shader_notify) {
             shader_notify->MarkShaderComplete();
         }
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <type_traits>
@@ -103,6 +104,13 @@ public:
         return is_built.load(std::memory_order::relaxed);
     }
 
+    /// Waits up to the given timeout for the pipeline to be built, returns true when it is
+    [[nodiscard]] bool WaitForBuild(std::chrono::nanoseconds timeout) {
+        std::unique_lock lock{build_mutex};
+        return build_condvar.wait_for(lock, timeout,
+                                      [this] { return is_built.load(std::memory_order::relaxed); });
+    }
+
     template <typename Spec>
     static auto MakeConfigureSpecFunc() {
         return [](GraphicsPipeline* pl, bool is_indexed) { pl->ConfigureImpl<Spec>(is_indexed); };
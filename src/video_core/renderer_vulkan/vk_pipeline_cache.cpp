@@ -6,11 +6,14 @@
 #include <cstddef>
 #include <fstream>
 #include <memory>
+#include <optional>
+#include <span>
 #include <thread>
 #include <vector>
 
 #include "common/bit_cast.h"
 #include "common/cityhash.h"
+#include "common/fs/file_lock.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/microprofile.h"
@@ -57,6 +60,166 @@ using VideoCommon::GraphicsEnvironment;
 constexpr u32 CACHE_VERSION = 11;
 constexpr std::array<char, 8> VULKAN_CACHE_MAGIC_NUMBER{'y', 'u', 'z', 'u', 'v', 'k', 'c', 'h'};
 
+struct DriverCacheHeader {
+    std::array<char, 8> magic_number;
+    u32 cache_version;
+    u32 padding;
+    u64 data_size;
+    u64 data_hash;
+};
+static_assert(std::is_trivially_copyable_v<DriverCacheHeader>);
+
+std::vector<char> GetPipelineCacheData(const vk::PipelineCache& pipeline_cache) {
+    size_t cache_size = 0;
+    std::vector<char> cache_data;
+    if (pipeline_cache) {
+        pipeline_cache.Read(&cache_size, nullptr);
+        cache_data.resize(cache_size);
+        pipeline_cache.Read(&cache_size, cache_data.data());
+        cache_data.resize(cache_size);
+    }
+    return cache_data;
+}
+
+vk::PipelineCache CreateDriverPipelineCache(const Device& device, std::span<const char> data) {
+    return device.GetLogical().CreatePipelineCache({
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .initialDataSize = data.size(),
+        .pInitialData = data.data(),
+    });
+}
+
+/// Writes a checksummed driver cache file, going through a temporary file so a crash while
+/// writing never leaves a truncated cache behind
+bool WriteDriverCacheFile(const std::filesystem::path& filename, std::span<const char> data,
+                          u32 cache_version) {
+    const DriverCacheHeader header{
+        .magic_number = VULKAN_CACHE_MAGIC_NUMBER,
+        .cache_version = cache_version,
+        .padding = 0,
+        .data_size = data.size(),
+        .data_hash = Common::CityHash64(data.data(), data.size()),
+    };
+    std::filesystem::path temp_filename{filename};
+    temp_filename += ".tmp";
+    // Instances sharing the shader directory would otherwise write the same temporary file
+    std::optional<Common::FS::FileLock> lock;
+    if (Settings::values.shared_cache.GetValue()) {
+        std::filesystem::path lock_filename{filename};
+        lock_filename += ".lock";
+        lock.emplace(lock_filename, Common::FS::FileLockMode::Exclusive);
+    }
+    try {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        file.exceptions(std::ofstream::failbit);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header))
+            .write(data.data(), data.size());
+        file.close();
+    } catch (const std::ios_base::failure& e) {
+        LOG_ERROR(Common_Filesystem, "Failed to write Vulkan driver pipeline cache file {}: {}",
+                  Common::FS::PathToUTF8String(filename), e.what());
+        Common::FS::RemoveFile(temp_filename);
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_filename, filename, ec);
+    if (ec) {
+        LOG_ERROR(Common_Filesystem, "Failed to replace Vulkan driver pipeline cache file {}: {}",
+                  Common::FS::PathToUTF8String(filename), ec.message());
+        Common::FS::RemoveFile(temp_filename);
+        return false;
+    }
+    return true;
+}
+
+/// Reads a driver cache file, deleting it when it is outdated or fails its integrity check
+std::optional<std::vector<char>> ReadDriverCacheFile(const std::filesystem::path& filename,
+                                                     u32 expected_cache_version) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    bool is_valid = false;
+    std::vector<char> cache_data;
+    try {
+        file.exceptions(std::ifstream::failbit);
+        const auto file_size = static_cast<size_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+
+        DriverCacheHeader header{};
+        if (file_size >= sizeof(header)) {
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        }
+        if (header.magic_number == VULKAN_CACHE_MAGIC_NUMBER &&
+            header.cache_version == expected_cache_version &&
+            header.data_size == file_size - sizeof(header)) {
+            cache_data.resize(header.data_size);
+            file.read(cache_data.data(), cache_data.size());
+            is_valid = Common::CityHash64(cache_data.data(), cache_data.size()) == header.data_hash;
+        }
+    } catch (const std::ios_base::failure& e) {
+        LOG_ERROR(Common_Filesystem, "{}", e.what());
+    }
+    if (is_valid) {
+        return cache_data;
+    }
+    file.close();
+    LOG_INFO(Common_Filesystem, "Deleting invalid or outdated Vulkan driver pipeline cache file {}",
+             Common::FS::PathToUTF8String(filename));
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete Vulkan driver pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+    return std::nullopt;
+}
+
+/// Moves the driver cache of older versions, written without a checksum, into the checksummed
+/// cache file so it is not lost on upgrade
+void MigrateLegacyDriverCache(const std::filesystem::path& filename,
+                              const std::filesystem::path& new_filename,
+                              u32 expected_cache_version) {
+    if (!Common::FS::Exists(new_filename)) {
+        std::optional<std::vector<char>> cache_data;
+        try {
+            std::ifstream file(filename, std::ios::binary | std::ios::ate);
+            file.exceptions(std::ifstream::failbit);
+            const auto file_size = static_cast<size_t>(file.tellg());
+            file.seekg(0, std::ios::beg);
+
+            std::array<char, 8> magic_number{};
+            u32 cache_version{};
+            constexpr size_t header_size = sizeof(magic_number) + sizeof(cache_version);
+            if (file_size >= header_size) {
+                file.read(magic_number.data(), magic_number.size())
+                    .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+            }
+            if (magic_number == VULKAN_CACHE_MAGIC_NUMBER &&
+                cache_version == expected_cache_version) {
+                cache_data.emplace(file_size - header_size);
+                file.read(cache_data->data(), cache_data->size());
+            }
+        } catch (const std::ios_base::failure& e) {
+            LOG_ERROR(Common_Filesystem, "{}", e.what());
+            cache_data.reset();
+        }
+        if (cache_data && !WriteDriverCacheFile(new_filename, *cache_data,
+                                                expected_cache_version)) {
+            // Keep the old cache around, the next boot tries again
+            return;
+        }
+        if (cache_data) {
+            LOG_INFO(Common_Filesystem, "Migrated Vulkan driver pipeline cache to {}",
+                     Common::FS::PathToUTF8String(new_filename));
+        }
+    }
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete Vulkan driver pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
 template <typename Container>
 auto MakeSpan(Container& container) {
     return std::span(container.data(), container.size());
@@ -421,8 +584,8 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
 
 PipelineCache::~PipelineCache() {
     if (use_vulkan_pipeline_cache && !vulkan_pipeline_cache_filename.empty()) {
-        SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
-                                     CACHE_VERSION);
+        serialization_thread.WaitForRequests();
+        SerializeVulkanPipelineCache();
     }
 }
 
@@ -544,9 +707,15 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     pipeline_cache_filename = base_dir / "vulkan.bin";
 
     if (use_vulkan_pipeline_cache) {
-        vulkan_pipeline_cache_filename = base_dir / "vulkan_pipelines.bin";
+        const auto legacy_filename{base_dir / "vulkan_pipelines.bin"};
+        vulkan_pipeline_cache_filename = base_dir / "vulkan_driver_pipelines.bin";
+        if (Common::FS::Exists(legacy_filename)) {
+            MigrateLegacyDriverCache(legacy_filename, vulkan_pipeline_cache_filename,
+                                     CACHE_VERSION);
+        }
         vulkan_pipeline_cache =
             LoadVulkanPipelineCache(vulkan_pipeline_cache_filename, CACHE_VERSION);
+        vulkan_pipeline_cache.Read(&vulkan_pipeline_cache_serialized_size, nullptr);
     }
 
     struct {
@@ -642,8 +811,8 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
     workers.WaitForRequests(stop_loading);
 
     if (use_vulkan_pipeline_cache) {
-        SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
-                                     CACHE_VERSION);
+        // Only written when loading compiled pipelines the driver did not know about
+        serialization_thread.QueueWork([this] { SerializeVulkanPipelineCache(); });
     }
 
     if (state.statistics) {
@@ -667,16 +836,22 @@ GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
     return BuiltPipeline(current_pipeline);
 }
 
-GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) const noexcept {
+GraphicsPipeline* PipelineCache::BuiltPipeline(GraphicsPipeline* pipeline) {
     if (pipeline->IsBuilt()) {
         return pipeline;
     }
     if (!use_asynchronous_shaders) {
         return pipeline;
     }
-    // When asynchronous shaders are enabled, avoid blocking the main thread completely.
-    // Skip the draw until the pipeline is ready to prevent stutter.
-    return nullptr;
+    // When asynchronous shaders are enabled, only block within the per-frame budget.
+    // Otherwise skip the draw until the pipeline is ready to prevent stutter.
+    const bool use_pipeline = pipeline_wait_budget.Acquire(
+        [pipeline](std::chrono::nanoseconds timeout) { return pipeline->WaitForBuild(timeout); });
+    return use_pipeline ? pipeline : nullptr;
+}
+
+void PipelineCache::TickFrame() {
+    pipeline_wait_budget.NextFrame();
 }
 
 std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
@@ -883,99 +1058,24 @@ std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
     return nullptr;
 }
 
-void PipelineCache::SerializeVulkanPipelineCache(const std::filesystem::path& filename,
-                                                 const vk::PipelineCache& pipeline_cache,
-                                                 u32 cache_version) try {
-    std::ofstream file(filename, std::ios::binary);
-    file.exceptions(std::ifstream::failbit);
-    if (!file.is_open()) {
-        LOG_ERROR(Common_Filesystem, "Failed to open Vulkan driver pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-        return;
-    }
-    file.write(VULKAN_CACHE_MAGIC_NUMBER.data(), VULKAN_CACHE_MAGIC_NUMBER.size())
-        .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
-
-    size_t cache_size = 0;
-    std::vector<char> cache_data;
-    if (pipeline_cache) {
-        pipeline_cache.Read(&cache_size, nullptr);
-        cache_data.resize(cache_size);
-        pipeline_cache.Read(&cache_size, cache_data.data());
-    }
-    file.write(cache_data.data(), cache_size);
-
-    LOG_INFO(Render_Vulkan, "Vulkan driver pipelines cached at: {}",
-             Common::FS::PathToUTF8String(filename));
-
-} catch (const std::ios_base::failure& e) {
-    LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete Vulkan driver pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-    }
-}
-
 vk::PipelineCache PipelineCache::LoadVulkanPipelineCache(const std::filesystem::path& filename,
                                                          u32 expected_cache_version) {
-    const auto create_pipeline_cache = [this](size_t data_size, const void* data) {
-        VkPipelineCacheCreateInfo pipeline_cache_ci = {
-            .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-            .pNext = nullptr,
-            .flags = 0,
-            .initialDataSize = data_size,
-            .pInitialData = data};
-        return device.GetLogical().CreatePipelineCache(pipeline_cache_ci);
-    };
-    try {
-        std::ifstream file(filename, std::ios::binary | std::ios::ate);
-        if (!file.is_open()) {
-            return create_pipeline_cache(0, nullptr);
-        }
-        file.exceptions(std::ifstream::failbit);
-        const auto end{file.tellg()};
-        file.seekg(0, std::ios::beg);
-
-        std::array<char, 8> magic_number;
-        u32 cache_version;
-        file.read(magic_number.data(), magic_number.size())
-            .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
-        if (magic_number != VULKAN_CACHE_MAGIC_NUMBER || cache_version != expected_cache_version) {
-            file.close();
-            if (Common::FS::RemoveFile(filename)) {
-                if (magic_number != VULKAN_CACHE_MAGIC_NUMBER) {
-                    LOG_ERROR(Common_Filesystem, "Invalid Vulkan driver pipeline cache file");
-                }
-                if (cache_version != expected_cache_version) {
-                    LOG_INFO(Common_Filesystem, "Deleting old Vulkan driver pipeline cache");
-                }
-            } else {
-                LOG_ERROR(Common_Filesystem,
-                          "Invalid Vulkan pipeline cache file and failed to delete it in \"{}\"",
-                          Common::FS::PathToUTF8String(filename));
-            }
-            return create_pipeline_cache(0, nullptr);
-        }
-
-        static constexpr size_t header_size = magic_number.size() + sizeof(cache_version);
-        const size_t cache_size = static_cast<size_t>(end) - header_size;
-        std::vector<char> cache_data(cache_size);
-        file.read(cache_data.data(), cache_size);
-
-        LOG_INFO(Render_Vulkan,
-                 "Loaded Vulkan driver pipeline cache: ", Common::FS::PathToUTF8String(filename));
-
-        return create_pipeline_cache(cache_size, cache_data.data());
-
-    } catch (const std::ios_base::failure& e) {
-        LOG_ERROR(Common_Filesystem, "{}", e.what());
-        if (!Common::FS::RemoveFile(filename)) {
-            LOG_ERROR(Common_Filesystem, "Failed to delete Vulkan driver pipeline cache file {}",
-                      Common::FS::PathToUTF8String(filename));
-        }
+    const auto cache_data = ReadDriverCacheFile(filename, expected_cache_version);
+    return CreateDriverPipelineCache(device,
+                                     cache_data ? *cache_data : std::span<const char>{});
+}
 
-        return create_pipeline_cache(0, nullptr);
+void PipelineCache::SerializeVulkanPipelineCache() {
+    const std::vector<char> cache_data = GetPipelineCacheData(vulkan_pipeline_cache);
+    if (cache_data.size() == vulkan_pipeline_cache_serialized_size) {
+        return;
     }
+    if (!WriteDriverCacheFile(vulkan_pipeline_cache_filename, cache_data, CACHE_VERSION)) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Vulkan driver pipelines cached at: {}",
+             Common::FS::PathToUTF8String(vulkan_pipeline_cache_filename));
+    vulkan_pipeline_cache_serialized_size = cache_data.size();
 }
 
 } // namespace Vulkan
@@ -22,6 +22,7 @@
 #include "shader_recompiler/profile.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/pipeline_wait_budget.h"
 #include "video_core/renderer_vulkan/fixed_pipeline_state.h"
 #include "video_core/renderer_vulkan/vk_buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
@@ -114,10 +115,13 @@ public:
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback);
 
+    /// Refills the per-frame budget for waiting on asynchronously built pipelines
+    void TickFrame();
+
 private:
     [[nodiscard]] GraphicsPipeline* CurrentGraphicsPipelineSlowPath();
 
-    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline) const noexcept;
+    [[nodiscard]] GraphicsPipeline* BuiltPipeline(GraphicsPipeline* pipeline);
 
     std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
 
@@ -135,12 +139,12 @@ private:
                                                            PipelineStatistics* statistics,
                                                            bool build_in_parallel);
 
-    void SerializeVulkanPipelineCache(const std::filesystem::path& filename,
-                                      const vk::PipelineCache& pipeline_cache, u32 cache_version);
-
     vk::PipelineCache LoadVulkanPipelineCache(const std::filesystem::path& filename,
                                               u32 expected_cache_version);
 
+    /// Writes the driver pipeline cache if it grew since it was loaded or last written
+    void SerializeVulkanPipelineCache();
+
     /// Evicts old unused pipelines to free memory when under pressure
     void EvictOldPipelines();
 
@@ -160,6 +164,7 @@ public:
     VideoCore::ShaderNotify& shader_notify;
     bool use_asynchronous_shaders{};
     bool use_vulkan_pipeline_cache{};
+    VideoCommon::PipelineWaitBudget pipeline_wait_budget;
 
     GraphicsPipelineCacheKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
@@ -182,6 +187,7 @@ public:
 
     std::filesystem::path vulkan_pipeline_cache_filename;
     vk::PipelineCache vulkan_pipeline_cache;
+    size_t vulkan_pipeline_cache_serialized_size{};
 
     Common::ThreadWorker workers;
     Common::ThreadWorker serialization_thread;
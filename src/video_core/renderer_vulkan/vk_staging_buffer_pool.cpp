@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <algorithm>
+#include <chrono>
 #include <utility>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "common/bit_util.h"
 #include "common/common_types.h"
 #include "common/literals.h"
+#include "common/logging/log.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_staging_buffer_pool.h"
 #include "video_core/vulkan_common/vulkan_device.h"
@@ -28,6 +30,8 @@ using namespace Common::Literals;
 constexpr VkDeviceSize MAX_ALIGNMENT = 256;
 // Stream buffer size in bytes
 constexpr VkDeviceSize MAX_STREAM_BUFFER_SIZE = 128_MiB;
+// Download ring size in bytes, large enough for most synchronous buffer and texture flushes
+constexpr VkDeviceSize DOWNLOAD_STREAM_BUFFER_SIZE = 32_MiB;
 
 size_t GetStreamBufferSize(const Device& device) {
     VkDeviceSize size{0};
@@ -50,36 +54,47 @@ size_t GetStreamBufferSize(const Device& device) {
 
 StagingBufferPool::StagingBufferPool(const Device& device_, MemoryAllocator& memory_allocator_,
                                      Scheduler& scheduler_)
-    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_},
-      stream_buffer_size{GetStreamBufferSize(device)}, region_size{stream_buffer_size /
-                                                                   StagingBufferPool::NUM_SYNCS} {
-    VkBufferCreateInfo stream_ci = {
-        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-        .pNext = nullptr,
-        .flags = 0,
-        .size = stream_buffer_size,
-        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
-                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-        .queueFamilyIndexCount = 0,
-        .pQueueFamilyIndices = nullptr,
-    };
+    : device{device_}, memory_allocator{memory_allocator_}, scheduler{scheduler_} {
+    VkBufferUsageFlags upload_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT |
+                                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
     if (device.IsExtTransformFeedbackSupported()) {
-        stream_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+        upload_usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
     }
-    stream_buffer = memory_allocator.CreateBuffer(stream_ci, MemoryUsage::Stream);
-    if (device.HasDebuggingToolAttached()) {
-        stream_buffer.SetObjectNameEXT("Stream Buffer");
-    }
-    stream_pointer = stream_buffer.Mapped();
-    ASSERT_MSG(!stream_pointer.empty(), "Stream buffer must be host visible!");
+    CreateStreamRing(upload_ring, GetStreamBufferSize(device), upload_usage, MemoryUsage::Stream,
+                     "Stream Buffer");
+    CreateStreamRing(download_ring, DOWNLOAD_STREAM_BUFFER_SIZE,
+                     VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                     MemoryUsage::Download, "Download Stream Buffer");
 }
 
-StagingBufferPool::~StagingBufferPool() = default;
+StagingBufferPool::~StagingBufferPool() {
+    LOG_DEBUG(Render_Vulkan,
+              "Staging requests: upload ring {} ({} overflows), download ring {} ({} overflows), "
+              "{} dedicated allocations, {} readback waits blocking for {} ms",
+              statistics.upload_ring_requests, statistics.upload_ring_overflows,
+              statistics.download_ring_requests, statistics.download_ring_overflows,
+              statistics.dedicated_allocations, statistics.readback_waits,
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                  statistics.readback_stall_time)
+                  .count());
+}
 
 StagingBufferRef StagingBufferPool::Request(size_t size, MemoryUsage usage, bool deferred) {
-    if (!deferred && usage == MemoryUsage::Upload && size <= region_size) {
-        return GetStreamBuffer(size);
+    if (!deferred && usage == MemoryUsage::Upload && size <= upload_ring.region_size) {
+        if (const auto ref = TryGetStreamBuffer(upload_ring, size)) {
+            ++statistics.upload_ring_requests;
+            return *ref;
+        }
+        ++statistics.upload_ring_overflows;
+    } else if (!deferred && usage == MemoryUsage::Download &&
+               size <= download_ring.region_size) {
+        if (const auto ref = TryGetStreamBuffer(download_ring, size)) {
+            ++statistics.download_ring_requests;
+            return *ref;
+        }
+        ++statistics.download_ring_overflows;
     }
     return GetStagingBuffer(size, usage, deferred);
 }
@@ -96,6 +111,13 @@ void StagingBufferPool::FreeDeferred(StagingBufferRef& ref) {
     it->deferred = false;
 }
 
+void StagingBufferPool::FinishReadback() {
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.Finish();
+    statistics.readback_stall_time += std::chrono::steady_clock::now() - start;
+    ++statistics.readback_waits;
+}
+
 void StagingBufferPool::TickFrame() {
     current_delete_level = (current_delete_level + 1) % NUM_LEVELS;
 
@@ -123,7 +145,7 @@ void StagingBufferPool::TickFrame() {
 }
 
 u64 StagingBufferPool::GetMemoryUsage() const {
-    u64 total_usage = stream_buffer_size;
+    u64 total_usage = upload_ring.size + download_ring.size;
 
     // Add usage from all staging buffer caches
     const auto& device_local_entries = device_local_cache;
@@ -161,47 +183,73 @@ u64 StagingBufferPool::GetMemoryUsage() const {
     return total_usage;
 }
 
-StagingBufferRef StagingBufferPool::GetStreamBuffer(size_t size) {
-    if (AreRegionsActive(Region(free_iterator) + 1,
-                         std::min(Region(iterator + size) + 1, NUM_SYNCS))) {
+void StagingBufferPool::CreateStreamRing(StreamRing& ring, VkDeviceSize size,
+                                         VkBufferUsageFlags usage, MemoryUsage memory_usage,
+                                         const char* name) {
+    const VkBufferCreateInfo buffer_ci = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .size = size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .queueFamilyIndexCount = 0,
+        .pQueueFamilyIndices = nullptr,
+    };
+    ring.buffer = memory_allocator.CreateBuffer(buffer_ci, memory_usage);
+    if (device.HasDebuggingToolAttached()) {
+        ring.buffer.SetObjectNameEXT(name);
+    }
+    ring.mapped = ring.buffer.Mapped();
+    ring.size = size;
+    ring.region_size = size / NUM_SYNCS;
+    ASSERT_MSG(!ring.mapped.empty(), "{} must be host visible!", name);
+}
+
+std::optional<StagingBufferRef> StagingBufferPool::TryGetStreamBuffer(StreamRing& ring,
+                                                                     size_t size) {
+    if (AreRegionsActive(ring, ring.Region(ring.free_iterator) + 1,
+                         std::min(ring.Region(ring.iterator + size) + 1, NUM_SYNCS))) {
         // Avoid waiting for the previous usages to be free
-        return GetStagingBuffer(size, MemoryUsage::Upload);
+        return std::nullopt;
     }
     const u64 current_tick = scheduler.CurrentTick();
-    std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + Region(iterator),
-              current_tick);
-    used_iterator = iterator;
-    free_iterator = std::max(free_iterator, iterator + size);
-
-    if (iterator + size >= stream_buffer_size) {
-        std::fill(sync_ticks.begin() + Region(used_iterator), sync_ticks.begin() + NUM_SYNCS,
-                  current_tick);
-        used_iterator = 0;
-        iterator = 0;
-        free_iterator = size;
-
-        if (AreRegionsActive(0, Region(size) + 1)) {
+    std::fill(ring.sync_ticks.begin() + ring.Region(ring.used_iterator),
+              ring.sync_ticks.begin() + ring.Region(ring.iterator), current_tick);
+    ring.used_iterator = ring.iterator;
+    ring.free_iterator = std::max(ring.free_iterator, ring.iterator + size);
+
+    if (ring.iterator + size >= ring.size) {
+        std::fill(ring.sync_ticks.begin() + ring.Region(ring.used_iterator),
+                  ring.sync_ticks.begin() + NUM_SYNCS, current_tick);
+        ring.used_iterator = 0;
+        ring.iterator = 0;
+        ring.free_iterator = size;
+
+        if (AreRegionsActive(ring, 0, ring.Region(size) + 1)) {
             // Avoid waiting for the previous usages to be free
-            return GetStagingBuffer(size, MemoryUsage::Upload);
+            return std::nullopt;
         }
     }
-    const size_t offset = iterator;
-    iterator = Common::AlignUp(iterator + size, MAX_ALIGNMENT);
+    const size_t offset = ring.iterator;
+    ring.iterator = Common::AlignUp(ring.iterator + size, MAX_ALIGNMENT);
     return StagingBufferRef{
-        .buffer = *stream_buffer,
+        .buffer = *ring.buffer,
         .offset = static_cast<VkDeviceSize>(offset),
-        .mapped_span = stream_pointer.subspan(offset, size),
+        .mapped_span = ring.mapped.subspan(offset, size),
         .usage{},
         .log2_level{},
         .index{},
     };
 }
 
-bool StagingBufferPool::AreRegionsActive(size_t region_begin, size_t region_end) const {
+bool StagingBufferPool::AreRegionsActive(const StreamRing& ring, size_t region_begin,
+                                         size_t region_end) const {
     const u64 gpu_tick = scheduler.GetMasterSemaphore().KnownGpuTick();
-    return std::any_of(sync_ticks.begin() + region_begin, sync_ticks.begin() + region_end,
+    return std::any_of(ring.sync_ticks.begin() + region_begin,
+                       ring.sync_ticks.begin() + region_end,
                        [gpu_tick](u64 sync_tick) { return gpu_tick < sync_tick; });
-};
+}
 
 StagingBufferRef StagingBufferPool::GetStagingBuffer(size_t size, MemoryUsage usage,
                                                      bool deferred) {
@@ -262,6 +310,7 @@ StagingBufferRef StagingBufferPool::CreateStagingBuffer(size_t size, MemoryUsage
         buffer_ci.usage |= VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
     }
     vk::Buffer buffer = memory_allocator.CreateBuffer(buffer_ci, usage);
+    ++statistics.dedicated_allocations;
     if (device.HasDebuggingToolAttached()) {
         ++buffer_index;
         buffer.SetObjectNameEXT(fmt::format("Staging Buffer {}", buffer_index).c_str());
@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <climits>
+#include <optional>
+#include <span>
 #include <vector>
 
 #include "common/common_types.h"
@@ -38,9 +42,13 @@ public:
     void FreeDeferred(StagingBufferRef& ref);
 
     [[nodiscard]] VkBuffer StreamBuf() const noexcept {
-        return *stream_buffer;
+        return *upload_ring.buffer;
     }
 
+    /// Submits pending work and waits for it to complete so readback memory can be consumed,
+    /// accounting the time spent blocked in the pool statistics.
+    void FinishReadback();
+
     void TickFrame();
 
     u64 GetMemoryUsage() const;
@@ -50,9 +58,33 @@ public:
     }
 
 private:
-    struct StreamBufferCommit {
-        size_t upper_bound;
-        u64 tick;
+    /// Counters describing how staging requests were served
+    struct Statistics {
+        u64 upload_ring_requests{};    ///< Uploads served from the upload ring
+        u64 upload_ring_overflows{};   ///< Uploads that fell back to a dedicated buffer
+        u64 download_ring_requests{};  ///< Readbacks served from the download ring
+        u64 download_ring_overflows{}; ///< Readbacks that fell back to a dedicated buffer
+        u64 dedicated_allocations{};   ///< Dedicated staging buffers created
+        u64 readback_waits{};          ///< Synchronous readback waits
+        std::chrono::nanoseconds readback_stall_time{}; ///< Time blocked on readbacks
+    };
+
+    /// Host visible ring buffer split in NUM_SYNCS regions, each guarded by the scheduler tick
+    /// of its last use.
+    struct StreamRing {
+        vk::Buffer buffer;
+        std::span<u8> mapped;
+        VkDeviceSize size{};
+        VkDeviceSize region_size{};
+
+        size_t iterator = 0;
+        size_t used_iterator = 0;
+        size_t free_iterator = 0;
+        std::array<u64, NUM_SYNCS> sync_ticks{};
+
+        size_t Region(size_t iter) const noexcept {
+            return iter / region_size;
+        }
     };
 
     struct StagingBuffer {
@@ -85,9 +117,12 @@ private:
     static constexpr size_t NUM_LEVELS = sizeof(size_t) * CHAR_BIT;
     using StagingBuffersCache = std::array<StagingBuffers, NUM_LEVELS>;
 
-    StagingBufferRef GetStreamBuffer(size_t size);
+    void CreateStreamRing(StreamRing& ring, VkDeviceSize size, VkBufferUsageFlags usage,
+                          MemoryUsage memory_usage, const char* name);
+
+    std::optional<StagingBufferRef> TryGetStreamBuffer(StreamRing& ring, size_t size);
 
-    bool AreRegionsActive(size_t region_begin, size_t region_end) const;
+    bool AreRegionsActive(const StreamRing& ring, size_t region_begin, size_t region_end) const;
 
     StagingBufferRef GetStagingBuffer(size_t size, MemoryUsage usage, bool deferred = false);
 
@@ -107,23 +142,13 @@ public:
     void TriggerCacheRelease(MemoryUsage usage) {
         ReleaseCache(usage);
     }
-    size_t Region(size_t iter) const noexcept {
-        return iter / region_size;
-    }
 
     const Device& device;
     MemoryAllocator& memory_allocator;
     Scheduler& scheduler;
 
-    vk::Buffer stream_buffer;
-    std::span<u8> stream_pointer;
-    VkDeviceSize stream_buffer_size;
-    VkDeviceSize region_size;
-
-    size_t iterator = 0;
-    size_t used_iterator = 0;
-    size_t free_iterator = 0;
-    std::array<u64, NUM_SYNCS> sync_ticks{};
+    StreamRing upload_ring;
+    StreamRing download_ring;
 
     StagingBuffersCache device_local_cache;
     StagingBuffersCache upload_cache;
@@ -133,6 +158,8 @@ public:
     u64 buffer_index = 0;
     u64 unique_ids{};
     u64 program_id{};
+
+    Statistics statistics;
 };
 
 } // namespace Vulkan
@@ -890,7 +890,7 @@ TextureCacheRuntime::TextureCacheRuntime(const Device& device_, Scheduler& sched
 }
 
 void TextureCacheRuntime::Finish() {
-    scheduler.Finish();
+    staging_buffer_pool.FinishReadback();
 }
 
 StagingBufferRef TextureCacheRuntime::UploadStagingBuffer(size_t size) {
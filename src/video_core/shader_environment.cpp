@@ -6,16 +6,19 @@
 #include <fstream>
 #include <memory>
 #include <optional>
+#include <sstream>
 #include <utility>
 
 #include "common/assert.h"
 #include "common/cityhash.h"
 #include "common/common_types.h"
 #include "common/div_ceil.h"
+#include "common/fs/file_lock.h"
 #include "common/fs/fs.h"
 #include "common/fs/path_util.h"
 #include "common/logging/log.h"
 #include "common/polyfill_ranges.h"
+#include "common/settings.h"
 #include "shader_recompiler/environment.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/memory_manager.h"
@@ -31,6 +34,38 @@ constexpr size_t INST_SIZE = sizeof(u64);
 
 using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
+/// In shared cache mode, pipeline cache files are shared by several running instances, which
+/// coordinate through a lock file next to the cache. Returns no lock otherwise.
+static std::optional<Common::FS::FileLock> LockCacheFile(const std::filesystem::path& filename,
+                                                         Common::FS::FileLockMode mode) {
+    if (!Settings::values.shared_cache.GetValue()) {
+        return std::nullopt;
+    }
+    auto path = filename;
+    path += ".lock";
+    return std::optional<Common::FS::FileLock>{std::in_place, path, mode};
+}
+
+/// Returns whether the pipeline cache file has a valid header for the expected version
+static bool IsCacheFileCurrent(const std::filesystem::path& filename,
+                               u32 expected_cache_version) {
+    std::ifstream file(filename, std::ios::binary);
+    std::array<char, 8> magic_number{};
+    u32 cache_version{};
+    file.read(magic_number.data(), magic_number.size())
+        .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
+    return file && magic_number == MAGIC_NUMBER && cache_version == expected_cache_version;
+}
+
+/// Deletes a pipeline cache file that failed to load or save
+static void RemoveCacheFile(const std::filesystem::path& filename) {
+    const auto lock{LockCacheFile(filename, Common::FS::FileLockMode::Exclusive)};
+    if (!Common::FS::RemoveFile(filename)) {
+        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
+                  Common::FS::PathToUTF8String(filename));
+    }
+}
+
 static u64 MakeCbufKey(u32 index, u32 offset) {
     return (static_cast<u64>(index) << 32) | offset;
 }
@@ -193,7 +228,7 @@ void GenericEnvironment::Dump(u64 pipeline_hash, u64 shader_hash) {
     DumpImpl(pipeline_hash, shader_hash, code, read_highest, read_lowest, initial_offset, stage);
 }
 
-void GenericEnvironment::Serialize(std::ofstream& file) const {
+void GenericEnvironment::Serialize(std::ostream& file) const {
     const u64 code_size{static_cast<u64>(CachedSizeBytes())};
     const u64 num_texture_types{static_cast<u64>(texture_types.size())};
     const u64 num_texture_pixel_formats{static_cast<u64>(texture_pixel_formats.size())};
@@ -584,6 +619,21 @@ std::optional<Shader::ReplaceConstant> FileEnvironment::GetReplaceConstBuffer(u3
 
 void SerializePipeline(std::span<const char> key, std::span<const GenericEnvironment* const> envs,
                        const std::filesystem::path& filename, u32 cache_version) try {
+    // Build the entry in memory first, so it is appended with a single write while holding the
+    // lock and other instances sharing the cache never observe a partial entry
+    std::ostringstream entry;
+    entry.exceptions(std::ios::failbit);
+    const bool can_serialize = std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized);
+    if (can_serialize) {
+        const u32 num_envs{static_cast<u32>(envs.size())};
+        entry.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
+        for (const GenericEnvironment* const env : envs) {
+            env->Serialize(entry);
+        }
+        entry.write(key.data(), key.size_bytes());
+    }
+
+    const auto lock{LockCacheFile(filename, Common::FS::FileLockMode::Exclusive)};
     std::ofstream file(filename, std::ios::binary | std::ios::ate | std::ios::app);
     file.exceptions(std::ifstream::failbit);
     if (!file.is_open()) {
@@ -596,34 +646,31 @@ void SerializePipeline(std::span<const char> key, std::span<const GenericEnviron
         file.write(MAGIC_NUMBER.data(), MAGIC_NUMBER.size())
             .write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
     }
-    if (!std::ranges::all_of(envs, &GenericEnvironment::CanBeSerialized)) {
+    if (!can_serialize) {
         return;
     }
-    const u32 num_envs{static_cast<u32>(envs.size())};
-    file.write(reinterpret_cast<const char*>(&num_envs), sizeof(num_envs));
-    for (const GenericEnvironment* const env : envs) {
-        env->Serialize(file);
-    }
-    file.write(key.data(), key.size_bytes());
+    const std::string_view data = entry.view();
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-    }
+    RemoveCacheFile(filename);
 }
 
 void LoadPipelines(
     std::stop_token stop_loading, const std::filesystem::path& filename, u32 expected_cache_version,
     Common::UniqueFunction<void, std::ifstream&, FileEnvironment> load_compute,
     Common::UniqueFunction<void, std::ifstream&, std::vector<FileEnvironment>> load_graphics) try {
+    // Entries are only appended while holding the lock, so the end read under it always falls
+    // on an entry boundary. Entries appended by other instances afterwards are not loaded.
+    auto lock{LockCacheFile(filename, Common::FS::FileLockMode::Shared)};
     std::ifstream file(filename, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
         return;
     }
     file.exceptions(std::ifstream::failbit);
     const auto end{file.tellg()};
+    lock.reset();
     file.seekg(0, std::ios::beg);
 
     std::array<char, 8> magic_number;
@@ -632,6 +679,11 @@ void LoadPipelines(
         .read(reinterpret_cast<char*>(&cache_version), sizeof(cache_version));
     if (magic_number != MAGIC_NUMBER || cache_version != expected_cache_version) {
         file.close();
+        // Another instance may have replaced the file since, only delete it if it is still stale
+        const auto delete_lock{LockCacheFile(filename, Common::FS::FileLockMode::Exclusive)};
+        if (delete_lock && IsCacheFileCurrent(filename, expected_cache_version)) {
+            return;
+        }
         if (Common::FS::RemoveFile(filename)) {
             if (magic_number != MAGIC_NUMBER) {
                 LOG_ERROR(Common_Filesystem, "Invalid pipeline cache file");
@@ -665,10 +717,7 @@ void LoadPipelines(
 
 } catch (const std::ios_base::failure& e) {
     LOG_ERROR(Common_Filesystem, "{}", e.what());
-    if (!Common::FS::RemoveFile(filename)) {
-        LOG_ERROR(Common_Filesystem, "Failed to delete pipeline cache file {}",
-                  Common::FS::PathToUTF8String(filename));
-    }
+    RemoveCacheFile(filename);
 }
 
 } // namespace VideoCommon
@@ -217,6 +217,7 @@ void Load(VkDevice device, DeviceDispatch& dld) noexcept {
     X(vkGetPipelineExecutableStatisticsKHR);
     X(vkGetSemaphoreCounterValue);
     X(vkMapMemory);
+    X(vkMergePipelineCaches);
     X(vkQueueSubmit);
     X(vkResetFences);
     X(vkResetQueryPool);
@@ -316,6 +316,7 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkGetQueryPoolResults vkGetQueryPoolResults{};
     PFN_vkGetSemaphoreCounterValue vkGetSemaphoreCounterValue{};
     PFN_vkMapMemory vkMapMemory{};
+    PFN_vkMergePipelineCaches vkMergePipelineCaches{};
     PFN_vkQueueSubmit vkQueueSubmit{};
     PFN_vkResetFences vkResetFences{};
     PFN_vkResetQueryPool vkResetQueryPool{};
@@ -902,6 +903,11 @@ public:
     VkResult Read(size_t* size, void* data) const noexcept {
         return dld->vkGetPipelineCacheData(owner, handle, size, data);
     }
+
+    /// Merges the contents of the given pipeline caches into this one.
+    void Merge(Span<VkPipelineCache> src_caches) const {
+        Check(dld->vkMergePipelineCaches(owner, handle, src_caches.size(), src_caches.data()));
+    }
 };
 
 class Semaphore : public Handle<VkSemaphore, VkDevice, DeviceDispatch> {